@@ -6,22 +6,6 @@ set(DEP_INSTALL_DIR ${PROJECT_BINARY_DIR}/install)
 set(DEP_INCLUDE_DIR ${DEP_INSTALL_DIR}/include)
 set(DEP_LIB_DIR ${DEP_INSTALL_DIR}/lib)
 
-# glfw
-ExternalProject_Add(
-    dep_glfw
-    GIT_REPOSITORY "https://github.com/glfw/glfw.git"
-    GIT_TAG "3.3.2"
-    GIT_SHALLOW 1
-    UPDATE_COMMAND "" PATCH_COMMAND "" TEST_COMMAND ""
-    CMAKE_ARGS
-        -DCMAKE_INSTALL_PREFIX=${DEP_INSTALL_DIR}
-        -DGLFW_BUILD_EXAMPLES=OFF
-        -DGLFW_BUILD_TESTS=OFF
-        -DGLFW_BUILD_DOCS=OFF
-)
-set(DEP_LIST ${DEP_LIST} dep_glfw)
-set(DEP_LIBS ${DEP_LIBS} glfw3)
-
 # glm
 ExternalProject_Add(
 	dep_glm
@@ -39,43 +23,62 @@ ExternalProject_Add(
 	)
 set(DEP_LIST ${DEP_LIST} dep_glm)
 
-# stb
-ExternalProject_Add(
-	dep_stb
-	GIT_REPOSITORY "https://github.com/nothings/stb"
-	GIT_TAG "master"
-	GIT_SHALLOW 1
-	UPDATE_COMMAND ""
-	PATCH_COMMAND ""
-	CONFIGURE_COMMAND ""
-	BUILD_COMMAND ""
-	TEST_COMMAND ""
-	INSTALL_COMMAND ${CMAKE_COMMAND} -E copy
-		${PROJECT_BINARY_DIR}/dep_stb-prefix/src/dep_stb/stb_image.h
-		${DEP_INSTALL_DIR}/include/stb/stb_image.h
+# 렌더러 전용 dependency
+if(ALE_BUILD_APP)
+	# glfw
+	ExternalProject_Add(
+	    dep_glfw
+	    GIT_REPOSITORY "https://github.com/glfw/glfw.git"
+	    GIT_TAG "3.3.2"
+	    GIT_SHALLOW 1
+	    UPDATE_COMMAND "" PATCH_COMMAND "" TEST_COMMAND ""
+	    CMAKE_ARGS
+	        -DCMAKE_INSTALL_PREFIX=${DEP_INSTALL_DIR}
+	        -DGLFW_BUILD_EXAMPLES=OFF
+	        -DGLFW_BUILD_TESTS=OFF
+	        -DGLFW_BUILD_DOCS=OFF
 	)
-set(DEP_LIST ${DEP_LIST} dep_stb)
+	set(DEP_LIST ${DEP_LIST} dep_glfw)
+	set(DEP_LIBS ${DEP_LIBS} glfw3)
 
-# assimp
-ExternalProject_Add(
-	dep_assimp
-	GIT_REPOSITORY "https://github.com/assimp/assimp"
-	GIT_TAG "v5.0.1"
-	GIT_SHALLOW 1
-	UPDATE_COMMAND ""
-	PATCH_COMMAND ""
-	CMAKE_ARGS
-		-DCMAKE_INSTALL_PREFIX=${DEP_INSTALL_DIR}
-		-DBUILD_SHARED_LIBS=OFF
-		-DASSIMP_BUILD_ASSIMP_TOOLS=OFF
-		-DASSIMP_BUILD_TESTS=OFF
-		-DASSIMP_INJECT_DEBUG_POSTFIX=OFF
-		-DASSIMP_BUILD_ZLIB=ON
-	TEST_COMMAND ""
-)
-set(DEP_LIST ${DEP_LIST} dep_assimp)
-set(DEP_LIBS ${DEP_LIBS}
-	assimp-vc143-mt$<$<CONFIG:Debug>:d>
-	zlibstatic$<$<CONFIG:Debug>:d>
-	IrrXML$<$<CONFIG:Debug>:d>
+	# stb
+	ExternalProject_Add(
+		dep_stb
+		GIT_REPOSITORY "https://github.com/nothings/stb"
+		GIT_TAG "master"
+		GIT_SHALLOW 1
+		UPDATE_COMMAND ""
+		PATCH_COMMAND ""
+		CONFIGURE_COMMAND ""
+		BUILD_COMMAND ""
+		TEST_COMMAND ""
+		INSTALL_COMMAND ${CMAKE_COMMAND} -E copy
+			${PROJECT_BINARY_DIR}/dep_stb-prefix/src/dep_stb/stb_image.h
+			${DEP_INSTALL_DIR}/include/stb/stb_image.h
+		)
+	set(DEP_LIST ${DEP_LIST} dep_stb)
+
+	# assimp
+	ExternalProject_Add(
+		dep_assimp
+		GIT_REPOSITORY "https://github.com/assimp/assimp"
+		GIT_TAG "v5.0.1"
+		GIT_SHALLOW 1
+		UPDATE_COMMAND ""
+		PATCH_COMMAND ""
+		CMAKE_ARGS
+			-DCMAKE_INSTALL_PREFIX=${DEP_INSTALL_DIR}
+			-DBUILD_SHARED_LIBS=OFF
+			-DASSIMP_BUILD_ASSIMP_TOOLS=OFF
+			-DASSIMP_BUILD_TESTS=OFF
+			-DASSIMP_INJECT_DEBUG_POSTFIX=OFF
+			-DASSIMP_BUILD_ZLIB=ON
+		TEST_COMMAND ""
 	)
+	set(DEP_LIST ${DEP_LIST} dep_assimp)
+	set(DEP_LIBS ${DEP_LIBS}
+		assimp-vc143-mt$<$<CONFIG:Debug>:d>
+		zlibstatic$<$<CONFIG:Debug>:d>
+		IrrXML$<$<CONFIG:Debug>:d>
+		)
+endif()
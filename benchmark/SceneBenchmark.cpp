@@ -0,0 +1,337 @@
+#include "physics/BoxShape.h"
+#include "physics/CapsuleShape.h"
+#include "physics/SphereShape.h"
+#include "physics/ThreadPool.h"
+#include "physics/World.h"
+
+#include <cstdio>
+#include <deque>
+#include <string>
+
+// 렌더러 없이 고정 장면을 N 스텝 돌려 단계별 시간을 측정하는 벤치마크
+// 사용법: ale_physics_benchmark [steps] [pyramid|wall|rain|capsule|shoot|spheres|level|all] [threads] [insert|refit]
+// threads가 1이면 scheduler 없이 한 스레드에서 실행
+// refit이면 broadphase를 refit mode로 실행
+
+namespace
+{
+const float TIME_STEP = 1.0f / 60.0f;
+const int32_t SHOOT_INTERVAL = 5;
+const int32_t SHOOT_ALIVE_MAX = 50;
+const float REFIT_REBUILD_RATIO = 1.5f;
+const glm::quat IDENTITY(1.0f, 0.0f, 0.0f, 0.0f);
+
+struct SceneShapes
+{
+	ale::BoxShape ground;
+	ale::BoxShape tile;
+	ale::BoxShape box;
+	ale::SphereShape sphere;
+	ale::CapsuleShape capsule;
+};
+
+std::vector<glm::vec3> createBoxPositions(const glm::vec3 &halfSize)
+{
+	std::vector<glm::vec3> positions;
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		positions.push_back(glm::vec3((i & 1) ? halfSize.x : -halfSize.x, (i & 2) ? halfSize.y : -halfSize.y,
+									  (i & 4) ? halfSize.z : -halfSize.z));
+	}
+	return positions;
+}
+
+std::vector<glm::vec3> createSpherePositions(float radius)
+{
+	return {glm::vec3(radius, 0.0f, 0.0f), glm::vec3(-radius, 0.0f, 0.0f), glm::vec3(0.0f, radius, 0.0f),
+			glm::vec3(0.0f, -radius, 0.0f), glm::vec3(0.0f, 0.0f, radius),	glm::vec3(0.0f, 0.0f, -radius)};
+}
+
+std::vector<glm::vec3> createCapsulePositions(float radius, float height)
+{
+	std::vector<glm::vec3> positions;
+	int32_t segments = 20;
+	float halfHeight = height * 0.5f;
+	float angleStep = 2.0f * glm::pi<float>() / static_cast<float>(segments);
+
+	for (int32_t i = 0; i < segments; ++i)
+	{
+		float theta = i * angleStep;
+		positions.push_back(glm::vec3(radius * cos(theta), halfHeight, radius * sin(theta)));
+		positions.push_back(glm::vec3(radius * cos(theta), -halfHeight, radius * sin(theta)));
+	}
+	positions.push_back(glm::vec3(0.0f, halfHeight + radius, 0.0f));
+	positions.push_back(glm::vec3(0.0f, -halfHeight - radius, 0.0f));
+	return positions;
+}
+
+void initShapes(SceneShapes &shapes)
+{
+	// App의 ground / box / sphere / capsule 모델과 같은 크기
+	shapes.ground.setVertices(createBoxPositions(glm::vec3(100.0f, 0.01f, 100.0f)));
+	shapes.ground.setType(ale::EType::GROUND);
+	shapes.tile.setVertices(createBoxPositions(glm::vec3(0.5f, 0.25f, 0.5f)));
+	shapes.tile.setType(ale::EType::GROUND);
+	shapes.box.setVertices(createBoxPositions(glm::vec3(0.5f)));
+	shapes.sphere.setShapeFeatures(createSpherePositions(0.5f));
+	shapes.capsule.setShapeFeatures(createCapsulePositions(0.5f, 1.0f));
+}
+
+int32_t addBody(ale::World &world, ale::Shape *shape, const glm::vec3 &position, int32_t xfId)
+{
+	world.createBody(shape, ale::Transform(position, IDENTITY), xfId);
+	return xfId + 1;
+}
+
+int32_t buildPyramid(ale::World &world, SceneShapes &shapes, int32_t xfId)
+{
+	int32_t base = 10;
+	for (int32_t y = 0; y < base; ++y)
+	{
+		int32_t count = base - y;
+		for (int32_t x = 0; x < count; ++x)
+		{
+			for (int32_t z = 0; z < count; ++z)
+			{
+				glm::vec3 position(x - count * 0.5f, static_cast<float>(y), z - count * 0.5f);
+				xfId = addBody(world, &shapes.box, position, xfId);
+			}
+		}
+	}
+	return xfId;
+}
+
+int32_t buildWall(ale::World &world, SceneShapes &shapes, int32_t xfId)
+{
+	int32_t width = 20;
+	int32_t height = 15;
+	for (int32_t y = 0; y < height; ++y)
+	{
+		float offset = (y % 2) * 0.5f;
+		for (int32_t x = 0; x < width; ++x)
+		{
+			glm::vec3 position(x + offset - width * 0.5f, static_cast<float>(y), 0.0f);
+			xfId = addBody(world, &shapes.box, position, xfId);
+		}
+	}
+	return xfId;
+}
+
+int32_t buildSphereRain(ale::World &world, SceneShapes &shapes, int32_t xfId)
+{
+	int32_t n = 10;
+	for (int32_t y = 0; y < 5; ++y)
+	{
+		for (int32_t x = 0; x < n; ++x)
+		{
+			for (int32_t z = 0; z < n; ++z)
+			{
+				glm::vec3 position(x * 1.5f - n * 0.75f, 5.0f + y * 2.0f, z * 1.5f - n * 0.75f);
+				xfId = addBody(world, &shapes.sphere, position, xfId);
+			}
+		}
+	}
+	return xfId;
+}
+
+// 바닥 위에 쌓이는 구 10648개 - sphere batch kernel이 주로 처리하는 장면
+int32_t buildSphereField(ale::World &world, SceneShapes &shapes, int32_t xfId)
+{
+	int32_t n = 22;
+	for (int32_t y = 0; y < n; ++y)
+	{
+		for (int32_t x = 0; x < n; ++x)
+		{
+			for (int32_t z = 0; z < n; ++z)
+			{
+				glm::vec3 position(x * 1.1f - n * 0.55f, 0.5f + y * 1.1f, z * 1.1f - n * 0.55f);
+				xfId = addBody(world, &shapes.sphere, position, xfId);
+			}
+		}
+	}
+	return xfId;
+}
+
+// 고정된 바닥 타일 2304개 위로 구가 떨어지는 장면 - static proxy가 많아도 broadphase 비용이 늘지 않아야 함
+int32_t buildLevel(ale::World &world, SceneShapes &shapes, int32_t xfId)
+{
+	int32_t n = 48;
+	for (int32_t x = 0; x < n; ++x)
+	{
+		for (int32_t z = 0; z < n; ++z)
+		{
+			glm::vec3 position(x - n * 0.5f, -0.25f + ((x + z) % 4) * 0.1f, z - n * 0.5f);
+			xfId = addBody(world, &shapes.tile, position, xfId);
+		}
+	}
+	return buildSphereRain(world, shapes, xfId);
+}
+
+int32_t buildCapsulePile(ale::World &world, SceneShapes &shapes, int32_t xfId)
+{
+	int32_t n = 6;
+	for (int32_t y = 0; y < 6; ++y)
+	{
+		for (int32_t x = 0; x < n; ++x)
+		{
+			for (int32_t z = 0; z < n; ++z)
+			{
+				glm::vec3 position(x * 1.2f - n * 0.6f + (y % 2) * 0.3f, 1.0f + y * 2.2f, z * 1.2f - n * 0.6f);
+				xfId = addBody(world, &shapes.capsule, position, xfId);
+			}
+		}
+	}
+	return xfId;
+}
+
+// wall에 sphere를 계속 쏘고 오래된 것부터 제거 - 생성 / 제거가 반복돼도 step 비용이 일정해야 함
+void shootSphere(ale::World &world, SceneShapes &shapes, std::deque<ale::Rigidbody *> &shots, int32_t step,
+				 int32_t xfId)
+{
+	if (step % SHOOT_INTERVAL != 0)
+	{
+		return;
+	}
+
+	float offset = static_cast<float>((step / SHOOT_INTERVAL) % 10) - 5.0f;
+	world.createBody(&shapes.sphere, ale::Transform(glm::vec3(offset, 3.0f, 15.0f), IDENTITY), xfId);
+
+	// 새 body는 body list 앞에 들어감
+	ale::Rigidbody *shot = world.getBodyList();
+	shot->setLinearVelocity(glm::vec3(0.0f, 0.0f, -30.0f));
+	shots.push_back(shot);
+
+	if (static_cast<int32_t>(shots.size()) > SHOOT_ALIVE_MAX)
+	{
+		world.destroyBody(shots.front());
+		shots.pop_front();
+	}
+}
+
+int32_t countContacts(ale::World &world)
+{
+	int32_t count = 0;
+	for (ale::Contact *contact = world.m_contactManager.m_contactList; contact != nullptr; contact = contact->getNext())
+	{
+		++count;
+	}
+	return count;
+}
+
+void runScene(const std::string &name, int32_t steps, SceneShapes &shapes, ale::TaskScheduler *scheduler,
+			  bool isRefitMode)
+{
+	ale::World world;
+	world.setTaskScheduler(scheduler);
+	world.m_contactManager.m_broadPhase.setRefitMode(isRefitMode, REFIT_REBUILD_RATIO);
+	int32_t xfId = addBody(world, &shapes.ground, glm::vec3(0.0f, -0.51f, 0.0f), 0);
+
+	if (name == "pyramid")
+	{
+		buildPyramid(world, shapes, xfId);
+	}
+	else if (name == "wall")
+	{
+		buildWall(world, shapes, xfId);
+	}
+	else if (name == "rain")
+	{
+		buildSphereRain(world, shapes, xfId);
+	}
+	else if (name == "capsule")
+	{
+		buildCapsulePile(world, shapes, xfId);
+	}
+	else if (name == "shoot")
+	{
+		xfId = buildWall(world, shapes, xfId);
+	}
+	else if (name == "spheres")
+	{
+		buildSphereField(world, shapes, xfId);
+	}
+	else if (name == "level")
+	{
+		buildLevel(world, shapes, xfId);
+	}
+	else
+	{
+		throw std::runtime_error("unknown scene: " + name);
+	}
+
+	std::deque<ale::Rigidbody *> shots;
+	ale::Profile total = {};
+	for (int32_t i = 0; i < steps; ++i)
+	{
+		if (name == "shoot")
+		{
+			shootSphere(world, shapes, shots, i, xfId);
+		}
+
+		world.startFrame();
+		world.runPhysics(TIME_STEP);
+
+		const ale::Profile &profile = world.getProfile();
+		total.step += profile.step;
+		total.integrate += profile.integrate;
+		total.broadPhase += profile.broadPhase;
+		total.narrowPhase += profile.narrowPhase;
+		total.solve += profile.solve;
+	}
+
+	float inv = 1.0f / static_cast<float>(steps);
+	std::printf("%-8s bodies %5d contacts %6d | ms/step %8.3f integrate %7.3f broad %7.3f narrow %8.3f solve %8.3f\n",
+				name.c_str(), world.getBodyCount(), countContacts(world), total.step * inv, total.integrate * inv,
+				total.broadPhase * inv, total.narrowPhase * inv, total.solve * inv);
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	int32_t steps = argc > 1 ? std::atoi(argv[1]) : 300;
+	std::string scene = argc > 2 ? argv[2] : "all";
+	int32_t threads = argc > 3 ? std::atoi(argv[3]) : 1;
+	std::string broadPhaseMode = argc > 4 ? argv[4] : "insert";
+
+	try
+	{
+		if (steps <= 0)
+		{
+			throw std::runtime_error("steps must be positive");
+		}
+		if (broadPhaseMode != "insert" && broadPhaseMode != "refit")
+		{
+			throw std::runtime_error("unknown broadphase mode: " + broadPhaseMode);
+		}
+		bool isRefitMode = broadPhaseMode == "refit";
+
+		SceneShapes shapes;
+		initShapes(shapes);
+
+		std::unique_ptr<ale::ThreadPool> threadPool;
+		if (threads != 1)
+		{
+			threadPool = std::make_unique<ale::ThreadPool>(threads);
+		}
+		std::printf("workers %d\n", threadPool ? threadPool->getWorkerCount() : 1);
+
+		if (scene == "all")
+		{
+			for (const char *name : {"pyramid", "wall", "rain", "capsule", "shoot", "spheres", "level"})
+			{
+				runScene(name, steps, shapes, threadPool.get(), isRefitMode);
+			}
+		}
+		else
+		{
+			runScene(scene, steps, shapes, threadPool.get(), isRefitMode);
+		}
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,260 @@
+#include "physics/DynamicTree.h"
+#include "physics/Timer.h"
+#include "physics/WideTree.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+
+// DynamicTree만 따로 떼어 tree 품질과 query 처리량을 측정하는 벤치마크
+// 사용법: ale_tree_benchmark [proxies] [rounds] [moveSteps] [rotationBudget]
+// insert  : createProxy로 하나씩 넣은 tree
+// churn   : 모든 proxy를 moveSteps번 움직여 remove / insert가 반복된 tree
+// rotate  : churn과 같은 움직임에 매 step rotate(rotationBudget)을 호출한 tree (churn보다 나빠짐, 비교용)
+// refit   : churn과 같은 움직임을 enlargeProxy + refit으로 처리하고 SAH 비용이 1.5배를 넘으면 rebuild한 tree
+// rebuild : churn tree를 binned SAH로 다시 만든 tree
+// bottomup: churn tree를 rebuildBottomUp으로 다시 만든 tree
+// 각 tree마다 SAH 비용, 높이, 모든 proxy의 fat AABB로 rounds번 query한 처리량을 DynamicTree와 WideTree로 출력
+// stack 행은 insert, churn tree에서 이전 traversal(queryWithStdStack)과 현재 query의 처리량을 같은 query로 비교
+
+namespace
+{
+const float WORLD_EXTENT_PER_PROXY = 1.2f;
+const float MIN_HALF_SIZE = 0.2f;
+const float MAX_HALF_SIZE = 0.8f;
+const float MAX_SPEED = 0.1f;
+const float REFIT_REBUILD_RATIO = 1.5f;
+
+enum class MoveMode
+{
+	REINSERT,
+	ROTATE,
+	REFIT
+};
+
+struct QueryCounter
+{
+	bool queryCallback(int32_t)
+	{
+		++hitCount;
+		return true;
+	}
+
+	int64_t hitCount = 0;
+};
+
+struct Proxy
+{
+	int32_t proxyId;
+	ale::AABB aabb;
+	glm::vec3 velocity;
+};
+
+float getExtent(int32_t proxyCount)
+{
+	// proxy 수가 늘어도 밀도가 같도록 공간 크기를 정함
+	return WORLD_EXTENT_PER_PROXY * std::cbrt(static_cast<float>(proxyCount));
+}
+
+void buildTree(ale::DynamicTree &tree, std::vector<Proxy> &proxies, int32_t proxyCount)
+{
+	float extent = getExtent(proxyCount);
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-extent, extent);
+	std::uniform_real_distribution<float> halfSize(MIN_HALF_SIZE, MAX_HALF_SIZE);
+	std::uniform_real_distribution<float> speed(-MAX_SPEED, MAX_SPEED);
+
+	proxies.reserve(proxyCount);
+	for (int32_t i = 0; i < proxyCount; ++i)
+	{
+		glm::vec3 center(position(random), position(random), position(random));
+		glm::vec3 half(halfSize(random), halfSize(random), halfSize(random));
+
+		Proxy proxy;
+		proxy.aabb.lowerBound = center - half;
+		proxy.aabb.upperBound = center + half;
+		proxy.velocity = glm::vec3(speed(random), speed(random), speed(random));
+		proxy.proxyId = tree.createProxy(proxy.aabb, nullptr);
+		proxies.push_back(proxy);
+	}
+}
+
+// 모든 proxy를 일정한 속도로 움직이고 공간 밖으로 나가면 반대로 튕김
+// refit mode에서 다시 만든 횟수 반환
+int32_t moveProxies(ale::DynamicTree &tree, std::vector<Proxy> proxies, int32_t steps, MoveMode mode,
+					int32_t rotationBudget)
+{
+	float extent = getExtent(static_cast<int32_t>(proxies.size()));
+	float baseCost = tree.getTotalCost();
+	int32_t rebuildCount = 0;
+	for (int32_t step = 0; step < steps; ++step)
+	{
+		for (Proxy &proxy : proxies)
+		{
+			for (int32_t axis = 0; axis < 3; ++axis)
+			{
+				if ((proxy.aabb.lowerBound[axis] < -extent && proxy.velocity[axis] < 0.0f) ||
+					(proxy.aabb.upperBound[axis] > extent && proxy.velocity[axis] > 0.0f))
+				{
+					proxy.velocity[axis] = -proxy.velocity[axis];
+				}
+			}
+
+			proxy.aabb.lowerBound += proxy.velocity;
+			proxy.aabb.upperBound += proxy.velocity;
+			if (mode == MoveMode::REFIT)
+			{
+				tree.enlargeProxy(proxy.proxyId, proxy.aabb, proxy.velocity);
+			}
+			else
+			{
+				tree.moveProxy(proxy.proxyId, proxy.aabb, proxy.velocity);
+			}
+		}
+
+		if (mode == MoveMode::ROTATE)
+		{
+			tree.rotate(rotationBudget);
+		}
+		else if (mode == MoveMode::REFIT)
+		{
+			// BroadPhase::refitDynamicTree와 같은 기준
+			tree.refit();
+			if (tree.getTotalCost() > baseCost * REFIT_REBUILD_RATIO)
+			{
+				tree.rebuild();
+				baseCost = tree.getTotalCost();
+				++rebuildCount;
+			}
+		}
+	}
+	return rebuildCount;
+}
+
+void report(const char *label, const ale::DynamicTree &tree, const std::vector<Proxy> &proxies, int32_t rounds,
+			float buildMs)
+{
+	int64_t queryCount = static_cast<int64_t>(proxies.size()) * rounds;
+
+	QueryCounter binaryCounter;
+	ale::Timer binaryTimer;
+	for (int32_t round = 0; round < rounds; ++round)
+	{
+		for (const Proxy &proxy : proxies)
+		{
+			tree.query(&binaryCounter, tree.getFatAABB(proxy.proxyId));
+		}
+	}
+	float binaryMs = binaryTimer.getMilliseconds();
+
+	ale::WideTree wideTree;
+	wideTree.build(tree);
+
+	QueryCounter wideCounter;
+	ale::Timer wideTimer;
+	for (int32_t round = 0; round < rounds; ++round)
+	{
+		for (const Proxy &proxy : proxies)
+		{
+			wideTree.query(&wideCounter, tree.getFatAABB(proxy.proxyId));
+		}
+	}
+	float wideMs = wideTimer.getMilliseconds();
+
+	std::printf("%-8s | build ms %9.3f | cost %12.0f height %3d | binary queries/s %10.0f | wide queries/s %10.0f | "
+				"hits/query %6.2f\n",
+				label, buildMs, tree.getTotalCost(), tree.getHeight(), queryCount / (binaryMs * 0.001f),
+				queryCount / (wideMs * 0.001f),
+				static_cast<float>(binaryCounter.hitCount) / static_cast<float>(queryCount));
+}
+
+// 같은 tree, 같은 query 집합으로 이전 traversal과 현재 query를 차례로 측정, hit 수가 다르면 예외
+void reportStackQuery(const char *label, const ale::DynamicTree &tree, const std::vector<Proxy> &proxies,
+					  int32_t rounds)
+{
+	int64_t queryCount = static_cast<int64_t>(proxies.size()) * rounds;
+
+	QueryCounter stackCounter;
+	ale::Timer stackTimer;
+	for (int32_t round = 0; round < rounds; ++round)
+	{
+		for (const Proxy &proxy : proxies)
+		{
+			tree.queryWithStdStack(&stackCounter, tree.getFatAABB(proxy.proxyId));
+		}
+	}
+	float stackMs = stackTimer.getMilliseconds();
+
+	QueryCounter currentCounter;
+	ale::Timer currentTimer;
+	for (int32_t round = 0; round < rounds; ++round)
+	{
+		for (const Proxy &proxy : proxies)
+		{
+			tree.query(&currentCounter, tree.getFatAABB(proxy.proxyId));
+		}
+	}
+	float currentMs = currentTimer.getMilliseconds();
+
+	if (stackCounter.hitCount != currentCounter.hitCount)
+	{
+		throw std::runtime_error("query results differ from std::stack traversal");
+	}
+
+	std::printf("stack    | %-8s | std::stack queries/s %10.0f | current queries/s %10.0f | speedup %5.2fx\n", label,
+				queryCount / (stackMs * 0.001f), queryCount / (currentMs * 0.001f), stackMs / currentMs);
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	int32_t proxyCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+	int32_t rounds = argc > 2 ? std::atoi(argv[2]) : 10;
+	int32_t moveSteps = argc > 3 ? std::atoi(argv[3]) : 100;
+	int32_t rotationBudget = argc > 4 ? std::atoi(argv[4]) : 64;
+
+	std::printf("proxies %d rounds %d moveSteps %d rotationBudget %d\n", proxyCount, rounds, moveSteps,
+				rotationBudget);
+
+	ale::DynamicTree tree;
+	std::vector<Proxy> proxies;
+	ale::Timer buildTimer;
+	buildTree(tree, proxies, proxyCount);
+	report("insert", tree, proxies, rounds, buildTimer.getMilliseconds());
+	reportStackQuery("insert", tree, proxies, rounds);
+
+	// 같은 시작 tree에 같은 움직임을 주고 회전 여부만 다르게 함
+	ale::DynamicTree rotated = tree;
+	ale::DynamicTree refitted = tree;
+	ale::Timer churnTimer;
+	moveProxies(tree, proxies, moveSteps, MoveMode::REINSERT, 0);
+	float churnMs = churnTimer.getMilliseconds();
+
+	ale::Timer rotateTimer;
+	moveProxies(rotated, proxies, moveSteps, MoveMode::ROTATE, rotationBudget);
+	float rotateMs = rotateTimer.getMilliseconds();
+
+	ale::Timer refitTimer;
+	int32_t refitRebuildCount = moveProxies(refitted, proxies, moveSteps, MoveMode::REFIT, 0);
+	float refitMs = refitTimer.getMilliseconds();
+
+	// 움직인 뒤의 fat AABB로 query
+	report("churn", tree, proxies, rounds, churnMs);
+	reportStackQuery("churn", tree, proxies, rounds);
+	report("rotate", rotated, proxies, rounds, rotateMs);
+	report("refit", refitted, proxies, rounds, refitMs);
+	std::printf("refit rebuilds %d / %d steps\n", refitRebuildCount, moveSteps);
+
+	ale::DynamicTree rebuilt = tree;
+	ale::Timer rebuildTimer;
+	rebuilt.rebuild();
+	report("rebuild", rebuilt, proxies, rounds, rebuildTimer.getMilliseconds());
+
+	ale::DynamicTree bottomUp = tree;
+	ale::Timer bottomUpTimer;
+	bottomUp.rebuildBottomUp();
+	report("bottomup", bottomUp, proxies, rounds, bottomUpTimer.getMilliseconds());
+	return 0;
+}
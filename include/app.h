@@ -31,6 +31,7 @@ class App
 
 	void createModels();
 	void createWorld();
+	void updateTransforms();
 
 	// draw 함수
 	void drawFrame();
@@ -47,6 +47,7 @@ class Mesh
 	Mesh() = default;
 	void init(DeviceManager *deviceManager, VkCommandPool commandPool, const std::vector<Vertex> &vertices,
 			  const std::vector<uint32_t> &indices);
+	static std::vector<glm::vec3> getPositions(const std::vector<Vertex> &vertices);
 
 	std::unique_ptr<VertexBuffer> vertexBuffer;
 	std::unique_ptr<IndexBuffer> indexBuffer;
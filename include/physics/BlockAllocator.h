@@ -1,7 +1,7 @@
 #ifndef BLOCKALLOCATOR_H
 #define BLOCKALLOCATOR_H
 
-#include "common.h"
+#include "physics/PhysicsCommon.h"
 
 namespace ale
 {
@@ -13,8 +13,13 @@ class BoxShape : public Shape
 	BoxShape *clone() const;
 	int32_t getChildCount() const;
 	void computeAABB(AABB *aabb, const Transform &xf) const;
-	void setVertices(const std::vector<Vertex> &v);
+	void setVertices(const std::vector<glm::vec3> &positions);
 	virtual ConvexInfo getShapeInfo(const Transform &transform) const override;
+	virtual glm::vec3 getSupportPoint(const glm::vec3 &dir) const override final
+	{
+		return m_center + glm::vec3(dir.x > 0 ? m_halfSize.x : -m_halfSize.x, dir.y > 0 ? m_halfSize.y : -m_halfSize.y,
+									dir.z > 0 ? m_halfSize.z : -m_halfSize.z);
+	}
 
 	// Vertex Info needed
 	std::set<glm::vec3, Vec3Comparator> m_vertices;
@@ -6,16 +6,38 @@
 namespace ale
 {
 
+struct ClipVertex
+{
+	glm::vec3 point;
+	uint32_t refFeature; // 0: incident face 꼭지점, 그 외: 잘린 reference 옆면 번호와 방향
+	uint32_t incFeature; // incident box 꼭지점 번호 (축별 부호 bit)
+};
+
 class BoxToBoxContact : public Contact
 {
   public:
 	static Contact *create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
+	static void destroy(Contact *contact);
 	BoxToBoxContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
 
-	virtual glm::vec3 supportA(const ConvexInfo &box, glm::vec3 dir) override;
-	virtual glm::vec3 supportB(const ConvexInfo &box, glm::vec3 dir) override;
+	virtual void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB) override;
 	virtual void findCollisionPoints(const ConvexInfo &boxA, const ConvexInfo &boxB, CollisionInfo &collisionInfo,
 									 EpaInfo &epaInfo, SimplexArray &simplexArray) override;
+
+  private:
+	float getOverlap(const ConvexInfo &boxA, const ConvexInfo &boxB, const glm::vec3 &axis,
+					 const glm::vec3 &distance);
+	void buildFaceContact(Manifold &manifold, const ConvexInfo &refBox, const ConvexInfo &incBox, int32_t refAxis,
+						  const glm::vec3 &refNormal, bool isFlipped);
+	void buildEdgeContact(Manifold &manifold, const ConvexInfo &boxA, const ConvexInfo &boxB, int32_t axisA,
+						  int32_t axisB, const glm::vec3 &normal, float overlap);
+	int32_t clipVertices(ClipVertex *output, const ClipVertex *input, int32_t inputCount,
+						 const glm::vec3 &planeNormal, float planeDist, int32_t planeIndex);
+
+	static const float FACE_RELATIVE_TOLERANCE;
+	static const float FACE_ABSOLUTE_TOLERANCE;
+	static const float EDGE_RELATIVE_TOLERANCE;
+	static const float EDGE_ABSOLUTE_TOLERANCE;
 };
 } // namespace ale
 
@@ -10,12 +10,17 @@ class BoxToCapsuleContact : public Contact
 {
   public:
 	static Contact *create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
+	static void destroy(Contact *contact);
 	BoxToCapsuleContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
 
-	virtual glm::vec3 supportA(const ConvexInfo &box, glm::vec3 dir) override;
-	virtual glm::vec3 supportB(const ConvexInfo &capsule, glm::vec3 dir) override;
+	virtual void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB) override;
 	virtual void findCollisionPoints(const ConvexInfo &box, const ConvexInfo &capsule, CollisionInfo &collisionInfo,
 									 EpaInfo &epaInfo, SimplexArray &simplexArray) override;
+
+  private:
+	bool isSegmentInBox(const glm::vec3 &start, const glm::vec3 &end, const glm::vec3 &halfSize);
+	float getClosestPoints(const glm::vec3 &start1, const glm::vec3 &end1, const glm::vec3 &start2,
+						   const glm::vec3 &end2, glm::vec3 &closest1, glm::vec3 &closest2);
 };
 } // namespace ale
 
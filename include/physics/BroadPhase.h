@@ -1,8 +1,9 @@
 #ifndef BROADPHASE_H
 #define BROADPHASE_H
 
-#include "Common.h"
+#include "physics/PhysicsCommon.h"
 #include "physics/DynamicTree.h"
+#include "physics/WideTree.h"
 #include <utility>
 
 namespace ale
@@ -19,8 +20,10 @@ class BroadPhase
 
 	BroadPhase();
 
-	// AABB에 해당하는 proxy 생성 - DynamicTree의 nodeId를 반환한다
-	int32_t createProxy(const AABB &aabb, void *userData);
+	// AABB에 해당하는 proxy 생성
+	// static body의 proxy는 static tree, 나머지는 dynamic tree에 넣음
+	// proxyId의 가장 아래 bit는 static 여부, 나머지 bit는 해당 tree의 nodeId
+	int32_t createProxy(const AABB &aabb, void *userData, bool isStatic);
 
 	// proxyId에 해당하는 node Destroy
 	void destroyProxy(int32_t proxyId);
@@ -29,37 +32,94 @@ class BroadPhase
 
 	void bufferMove(int32_t proxyId);
 
+	// 이번 step에 처리할 move buffer에서 proxyId 제거
+	void unBufferMove(int32_t proxyId);
+
 	// proxyId에 해당하는 FatAABB 반환
-	// const AABB &getFatAABB(int32_t proxyId) const;
+	const AABB &getFatAABB(int32_t proxyId) const;
 
-	// proxyId pair끼리 겹치는지 확인
-	// bool TestOverlap(int32_t proxyIdA, int32_t proxyIdB) const;
+	// proxyId pair의 fat AABB끼리 겹치는지 확인
+	bool testOverlap(int32_t proxyIdA, int32_t proxyIdB) const;
 
 	// proxyId에 해당하는 data get
-	// void *getUserData(int32_t proxyId) const;
+	void *getUserData(int32_t proxyId) const;
 
 	// moved proxy buffer를 순회하며, 가능성 있는 충돌 쌍 검색
+	// 움직인 dynamic proxy는 두 tree를, 새로 생긴 static proxy는 dynamic tree만 query
+	// 이번 step에 움직인 proxy의 쌍만 pair buffer에 모아 정렬 후 중복 제거
 	// callback을 사용해 ContactManager의 AddPair 호출
 	template <typename T> void updatePairs(T *callback);
 
+	// 켜면 updatePairs가 dynamic tree도 4갈래로 펼친 WideTree로 query (static tree는 항상 WideTree)
+	// tree 구조가 바뀐 step에는 다시 build하므로 대부분 멈춰 있는 큰 장면에서 유리
+	void setWideTreeQuery(bool enabled);
+
+	// 켜면 움직인 dynamic proxy를 다시 insert하지 않고 fat AABB만 키운 뒤 updatePairs 시작에 조상 aabb를 refit
+	// refit으로 SAH 비용이 마지막 rebuild 때의 rebuildCostRatio배를 넘으면 그때만 tree를 다시 만듦
+	// 조금씩 계속 움직이는 더미처럼 reinsert가 대부분인 장면용
+	void setRefitMode(bool enabled, float rebuildCostRatio);
+
 	// 추후 필요에 따라 수정
 	template <typename T> void query(T *callback, const AABB &aabb) const;
 
   private:
 	friend class DynamicTree;
-	bool queryCallback(int32_t proxyId);
+	friend class WideTree;
+	bool queryCallback(int32_t nodeId);
 
-	DynamicTree m_tree;
-	std::set<std::pair<int32_t, int32_t>> m_proxySet;
-	std::vector<int32_t> m_moveBuffer;
+	static int32_t makeProxyId(int32_t nodeId, bool isStatic);
+	static int32_t getNodeId(int32_t proxyId);
+	static bool isStaticProxy(int32_t proxyId);
+	const DynamicTree &getTree(int32_t proxyId) const;
+
+	// 새로 생겼거나 바뀐 static proxy가 있으면 static tree를 SAH로 다시 만듦
+	void updateStaticTree();
+
+	// refit mode에서 조상 aabb를 갱신하고 SAH 비용이 기준을 넘으면 다시 만듦
+	void refitDynamicTree();
+
+	// 움직이는 proxy끼리만 담아 static leaf 때문에 query가 깊어지지 않게 함
+	DynamicTree m_dynamicTree;
+	WideTree m_dynamicWideTree;
+	bool m_useWideTree;
+	bool m_isRefitMode;
+	float m_refitRebuildRatio;
+	float m_refitBaseCost; // 마지막으로 구조를 다시 만든 직후의 SAH 비용
+
+	// 거의 바뀌지 않는 static proxy, 바뀐 뒤 첫 updatePairs에서 한 번 다시 만듦
+	DynamicTree m_staticTree;
+	WideTree m_staticWideTree;
+	bool m_isStaticTreeDirty;
+
+	// 기존 dynamic proxy와 pair를 찾아야 하는 새 static proxy
+	std::vector<int32_t> m_newStaticProxies;
 
+	// step마다 비우고 다시 채우는 pair buffer, 메모리는 step 간에 재사용
+	std::vector<std::pair<int32_t, int32_t>> m_pairBuffer;
+	int32_t m_pairCapacity;
+	int32_t m_pairCount;
+
+	std::vector<int32_t> m_moveBuffer;
 	int32_t m_moveCapacity;
 	int32_t m_moveCount;
 	int32_t m_queryProxyId;
+	bool m_isQueryingStaticTree;
 };
 
 template <typename T> void BroadPhase::updatePairs(T *callback)
 {
+	m_pairCount = 0;
+
+	updateStaticTree();
+	if (m_isRefitMode)
+	{
+		refitDynamicTree();
+	}
+	if (m_useWideTree)
+	{
+		m_dynamicWideTree.update(m_dynamicTree);
+	}
+
 	for (int32_t i = 0; i < m_moveCount; ++i)
 	{
 		m_queryProxyId = m_moveBuffer[i];
@@ -68,56 +128,50 @@ template <typename T> void BroadPhase::updatePairs(T *callback)
 			continue;
 		}
 
-		const AABB &fatAABB = m_tree.getFatAABB(m_queryProxyId);
+		const AABB &fatAABB = getFatAABB(m_queryProxyId);
 
-		m_tree.query(this, fatAABB);
+		m_isQueryingStaticTree = false;
+		if (m_useWideTree)
+		{
+			m_dynamicWideTree.query(this, fatAABB);
+		}
+		else
+		{
+			m_dynamicTree.query(this, fatAABB);
+		}
+
+		m_isQueryingStaticTree = true;
+		m_staticWideTree.query(this, fatAABB);
 	}
 
 	m_moveCount = 0;
-	for (auto &it = m_proxySet.begin(); it != m_proxySet.end();)
+
+	// static끼리는 충돌하지 않으므로 새 static proxy는 dynamic tree만 확인
+	m_isQueryingStaticTree = false;
+	for (int32_t proxyId : m_newStaticProxies)
 	{
-		auto primaryPair = it;
-		// std::cout << "proxyIdA: " << primaryPair->first << " proxyIdB: " << primaryPair->second << '\n';
-		void *userDataA = m_tree.getUserData(primaryPair->first);
-		void *userDataB = m_tree.getUserData(primaryPair->second);
+		m_queryProxyId = proxyId;
+		m_dynamicTree.query(this, getFatAABB(proxyId));
+	}
+	m_newStaticProxies.clear();
+
+	// 둘 다 움직인 경우 같은 pair가 두 번 들어오므로 정렬 후 중복은 건너뜀
+	std::sort(m_pairBuffer.begin(), m_pairBuffer.begin() + m_pairCount);
+
+	for (int32_t i = 0; i < m_pairCount;)
+	{
+		const std::pair<int32_t, int32_t> &primaryPair = m_pairBuffer[i];
+		// std::cout << "proxyIdA: " << primaryPair.first << " proxyIdB: " << primaryPair.second << '\n';
+		void *userDataA = getUserData(primaryPair.first);
+		void *userDataB = getUserData(primaryPair.second);
 
 		callback->addPair(userDataA, userDataB);
-		++it;
-		while (it != m_proxySet.end())
+		++i;
+		while (i < m_pairCount && m_pairBuffer[i] == primaryPair)
 		{
-			auto pair = it;
-
-			if (pair->first != primaryPair->first || pair->second != primaryPair->second)
-			{
-				break;
-			}
-			++it;
+			++i;
 		}
 	}
-
-	// void *userDataA = m_tree.getUserData(0);
-	// void *userDataB = m_tree.getUserData(1);
-	// callback->addPair(userDataA, userDataB);
-
-	// void *userDataC = m_tree.getUserData(0);
-	// void *userDataD = m_tree.getUserData(3);
-	// callback->addPair(userDataC, userDataD);
-
-	// void *userDataE = m_tree.getUserData(0);
-	// void *userDataF = m_tree.getUserData(5);
-	// callback->addPair(userDataE, userDataF);
-
-	// void *userDataG = m_tree.getUserData(1);
-	// void *userDataH = m_tree.getUserData(3);
-	// callback->addPair(userDataG, userDataH);
-
-	// void *userData6 = m_tree.getUserData(1);
-	// void *userData7 = m_tree.getUserData(5);
-	// callback->addPair(userData6, userData7);
-
-	// void *userData8 = m_tree.getUserData(3);
-	// void *userData9 = m_tree.getUserData(5);
-	// callback->addPair(userData8, userData9);
 }
 } // namespace ale
 #endif
\ No newline at end of file
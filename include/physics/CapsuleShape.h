@@ -15,15 +15,36 @@ class CapsuleShape : public Shape
 	CapsuleShape *clone() const;
 	int32_t getChildCount() const;
 	void computeAABB(AABB *aabb, const Transform &xf) const;
-	void setShapeFeatures(const std::vector<Vertex> &vertices);
-	void computeCapsuleFeatures(const std::vector<Vertex> &vertices);
-	void createCapsulePoints();
+	void setShapeFeatures(const std::vector<glm::vec3> &positions);
+	void computeCapsuleFeatures(const std::vector<glm::vec3> &positions);
 	virtual ConvexInfo getShapeInfo(const Transform &transform) const override;
+	// 반구 중심 사이 선분의 support point에 radius만큼 dir 방향으로 이동
+	virtual glm::vec3 getSupportPoint(const glm::vec3 &dir) const override final
+	{
+		float dotResult = glm::dot(dir, m_axes[0]);
+		glm::vec3 point = m_center;
+
+		if (dotResult > 0.0f)
+		{
+			point += m_axes[0] * m_height * 0.5f;
+		}
+		else if (dotResult < 0.0f)
+		{
+			point -= m_axes[0] * m_height * 0.5f;
+		}
+
+		float length2 = glm::length2(dir);
+		if (length2 > 1e-12f)
+		{
+			point += dir * (m_radius / std::sqrt(length2));
+		}
+
+		return point;
+	}
 
 	float m_radius;
 	float m_height;
-	glm::vec3 m_axes[21];
-	glm::vec3 m_points[40];
+	glm::vec3 m_axes[3];
 	std::set<glm::vec3, Vec3Comparator> m_vertices;
 };
 } // namespace ale
@@ -10,13 +10,16 @@ class CapsuleToCapsuleContact : public Contact
 {
   public:
 	static Contact *create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
+	static void destroy(Contact *contact);
 	CapsuleToCapsuleContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
 
-	virtual glm::vec3 supportA(const ConvexInfo &capsule, glm::vec3 dir) override;
-	virtual glm::vec3 supportB(const ConvexInfo &capsule, glm::vec3 dir) override;
+	virtual void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB) override;
 	virtual void findCollisionPoints(const ConvexInfo &capsuleA, const ConvexInfo &capsuleB,
 									 CollisionInfo &collisionInfo, EpaInfo &epaInfo,
 									 SimplexArray &simplexArray) override;
+
+  private:
+	static const float PARALLEL_TOLERANCE;
 };
 } // namespace ale
 
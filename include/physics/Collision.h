@@ -1,7 +1,7 @@
 #ifndef COLLISION_H
 #define COLLISION_H
 
-#include "Common.h"
+#include "physics/PhysicsCommon.h"
 
 namespace ale
 {
@@ -109,15 +109,17 @@ inline bool testOverlap(const AABB &a, const AABB &b)
 
 struct ManifoldPoint
 {
-	float normalImpulse;  // 법선 방향 충격량
-	float tangentImpulse; // 접촉면 충격량
-	float seperation;	  // 관통 깊이
-	glm::vec3 pointA;	  // 충돌 지점의 위치
-	glm::vec3 pointB;	  // 충돌 지점의 위치
-	glm::vec3 normal;	  // 법선 벡터
+	float normalImpulse;		// 법선 방향 충격량 (누적)
+	glm::vec3 tangentImpulse;	// 접촉면 방향 충격량 (누적, bodyB 기준)
+	float velocityBias;			// 반발 계수로 인한 목표 법선 속도
+	float seperation;			// 관통 깊이
+	glm::vec3 pointA;			// 충돌 지점의 위치
+	glm::vec3 pointB;			// 충돌 지점의 위치
+	glm::vec3 normal;			// 법선 벡터
+	uint32_t id;				// 도형 type과 충돌한 면, 꼭지점 정보를 압축한 feature id
 };
 
-const int32_t MAX_MANIFOLD_COUNT = 40;
+const int32_t MAX_MANIFOLD_COUNT = 4;
 
 struct Manifold
 {
@@ -3,15 +3,19 @@
 
 #include "Fixture.h"
 #include "PhysicsAllocator.h"
+#include "SimdFloat.h"
 #include <cmath>
 
 namespace ale
 {
 
+// clipping 중간 결과 (원기둥 윗면 20각형끼리 자르면 최대 40개)
+const int32_t MAX_POLYGON_COUNT = 40;
+
 struct ContactPolygon
 {
-	glm::vec3 points[MAX_MANIFOLD_COUNT];
-	glm::vec3 buffer[MAX_MANIFOLD_COUNT];
+	glm::vec3 points[MAX_POLYGON_COUNT];
+	glm::vec3 buffer[MAX_POLYGON_COUNT];
 	int32_t pointsCount;
 };
 
@@ -19,47 +23,21 @@ struct Face
 {
 	glm::vec3 normal;
 	float distance;
-	glm::vec3 vertices[MAX_MANIFOLD_COUNT];
+	glm::vec3 vertices[MAX_POLYGON_COUNT];
 	int32_t verticesCount;
 };
 
 struct CollisionInfo
 {
-	glm::vec3 normal[MAX_MANIFOLD_COUNT];
-	glm::vec3 pointA[MAX_MANIFOLD_COUNT];
-	glm::vec3 pointB[MAX_MANIFOLD_COUNT];
-	float seperation[MAX_MANIFOLD_COUNT];
+	glm::vec3 normal[MAX_POLYGON_COUNT];
+	glm::vec3 pointA[MAX_POLYGON_COUNT];
+	glm::vec3 pointB[MAX_POLYGON_COUNT];
+	float seperation[MAX_POLYGON_COUNT];
 	int32_t size;
 };
 
 const int32_t MAX_SIMPLEX_COUNT = 100;
 
-struct FaceArray
-{
-	int32_t count;
-	int32_t maxCount;
-	int32_t *faces;
-	glm::vec4 *normals;
-
-	FaceArray()
-	{
-		count = 0;
-		maxCount = 64;
-
-		void *memory = PhysicsAllocator::m_blockAllocator.allocateBlock(3 * maxCount * sizeof(int32_t));
-		faces = static_cast<int32_t *>(memory);
-
-		memory = PhysicsAllocator::m_blockAllocator.allocateBlock(maxCount * sizeof(glm::vec4));
-		normals = static_cast<glm::vec4 *>(memory);
-	}
-};
-
-struct UniqueEdges
-{
-	std::pair<int32_t, int32_t> *edges;
-	int32_t size;
-};
-
 struct Simplex
 {
 	glm::vec3 diff;
@@ -73,16 +51,53 @@ struct SimplexArray
 	int32_t simplexCount;
 };
 
+// 닫힌 삼각형 다면체의 면 수는 2 * 꼭짓점 수 - 4를 넘지 않음
+const int32_t MAX_EPA_FACE_COUNT = 2 * MAX_SIMPLEX_COUNT;
+const int32_t MAX_EPA_EDGE_COUNT = 3 * MAX_EPA_FACE_COUNT;
+
+struct EpaFace
+{
+	glm::vec3 normal;
+	float distance;
+	int32_t indices[3];
+	int32_t heapIndex; // heap 안에서의 위치
+};
+
+struct EpaEdge
+{
+	int32_t first;
+	int32_t second;
+};
+
+// EPA 다면체를 담는 스레드별 고정 메모리
+// faces는 면 slot, heap은 distance 기준 min-heap (살아있는 면 번호), freeFaces는 지워진 면 slot
+struct EpaArena
+{
+	EpaFace faces[MAX_EPA_FACE_COUNT];
+	int32_t heap[MAX_EPA_FACE_COUNT];
+	int32_t freeFaces[MAX_EPA_FACE_COUNT];
+	int32_t visibleFaces[MAX_EPA_FACE_COUNT];
+	EpaEdge edges[MAX_EPA_EDGE_COUNT];
+	int32_t faceCount;
+	int32_t heapCount;
+	int32_t freeCount;
+	int32_t edgeCount;
+};
+
+// support point는 shape의 local support 함수를 transform으로 변환해서 구함
+// box는 axes에 3개의 면 축, cylinder/capsule은 axes[0]에 높이 축, axes[1], axes[2]에 수직 축
+// center, axes, halfSize는 모든 shape에서 도형을 감싸는 OBB가 됨
 struct ConvexInfo
 {
-	glm::vec3 *points {nullptr};
-	glm::vec3 *axes {nullptr};
-	int32_t pointsCount;
-	int32_t axesCount;
+	const Shape *shape;
+	glm::vec3 position;
+	glm::quat orientation;
+	glm::vec3 axes[3];
 	glm::vec3 halfSize;
 	glm::vec3 center;
 	float radius;
 	float height;
+	float boundingRadius;
 };
 
 struct EpaInfo
@@ -91,10 +106,66 @@ struct EpaInfo
 	float distance;
 };
 
+// manifold를 만들 때의 두 body 상대 자세와 접촉점의 body local 좌표
+struct ManifoldCache
+{
+	glm::vec3 relativePosition;
+	glm::quat relativeOrientation;
+	glm::vec3 localPointA[MAX_MANIFOLD_COUNT];
+	glm::vec3 localPointB[MAX_MANIFOLD_COUNT];
+	glm::vec3 localNormal[MAX_MANIFOLD_COUNT];
+	bool isValid;
+};
+
 class Contact;
 struct Manifold;
+struct ContactUpdate;
+
+// sphere batch kernel이 한 번에 모으는 쌍의 수 (SIMD_WIDTH의 배수)
+const int32_t SPHERE_BATCH_SIZE = 64;
+
+// SIMD로 한 번에 검사하는 sphere 쌍의 SoA 배열
+// radiusB가 0이면 B는 점 (sphere-box에서 box 위 최근접점)
+struct SphereBatch
+{
+	float centerAX[SPHERE_BATCH_SIZE];
+	float centerAY[SPHERE_BATCH_SIZE];
+	float centerAZ[SPHERE_BATCH_SIZE];
+	float radiusA[SPHERE_BATCH_SIZE];
+	float centerBX[SPHERE_BATCH_SIZE];
+	float centerBY[SPHERE_BATCH_SIZE];
+	float centerBZ[SPHERE_BATCH_SIZE];
+	float radiusB[SPHERE_BATCH_SIZE];
+
+	float normalX[SPHERE_BATCH_SIZE];
+	float normalY[SPHERE_BATCH_SIZE];
+	float normalZ[SPHERE_BATCH_SIZE];
+	float seperation[SPHERE_BATCH_SIZE];
+	bool isTouching[SPHERE_BATCH_SIZE];
+
+	ContactUpdate *contactUpdates[SPHERE_BATCH_SIZE];
+	int32_t count;
+};
+
+// narrowphase에서 갱신할 contact와 결과
+struct ContactUpdate
+{
+	Contact *contact;
+	int32_t pairType;
+	bool wasTouching;
+	bool touching;
+};
+
+// 상대 이동, 회전이 threshold 이하이면 manifold를 다시 계산하지 않고 재사용 (0이면 항상 재계산)
+struct ManifoldReuseThreshold
+{
+	float linear;
+	float angular;
+};
 
 using contactMemberFunction = Contact *(*)(Fixture *, Fixture *, int32_t, int32_t);
+using contactDestroyFunction = void (*)(Contact *);
+using contactUpdateFunction = void (*)(ContactUpdate *, const int32_t *, int32_t, const ManifoldReuseThreshold &);
 
 struct ContactLink
 {
@@ -121,20 +192,24 @@ class Contact
 {
   public:
 	static Contact *create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
+	static void destroy(Contact *contact);
+	// 같은 pair type인 contact들을 order 순서대로 갱신
+	static void updateBatch(int32_t pairType, ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+							const ManifoldReuseThreshold &reuseThreshold);
 
 	Contact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
-	void update();
-	void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB);
+	void update(const ManifoldReuseThreshold &reuseThreshold);
+	bool updateManifold(const ManifoldReuseThreshold &reuseThreshold);
+	virtual void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB);
 
 	void generateManifolds(CollisionInfo &collisionInfo, Manifold &manifold, Fixture *m_fixtureA, Fixture *m_fixtureB);
 	float getFriction() const;
 	float getRestitution() const;
 	int32_t getChildIndexA() const;
 	int32_t getChildIndexB() const;
-	int32_t getFaceNormals(SimplexArray &simplexArray, FaceArray &faceArray);
+	int32_t getPairType() const;
+	Contact *getPrev();
 	Contact *getNext();
-	Simplex getSupportPoint(const ConvexInfo &convexA, const ConvexInfo &convexB, glm::vec3 &dir);
-	EpaInfo getEpaResult(const ConvexInfo &convexA, const ConvexInfo &convexB, SimplexArray &simplexArray);
 	Fixture *getFixtureA() const;
 	Fixture *getFixtureB() const;
 	ContactLink *getNodeA();
@@ -149,20 +224,48 @@ class Contact
 
   protected:
 	static contactMemberFunction createContactFunctions[32];
+	static contactDestroyFunction destroyContactFunctions[32];
+	static contactUpdateFunction updateContactFunctions[32];
+	static thread_local EpaArena m_epaArena;
+
+	// T의 evaluate를 virtual dispatch 없이 호출하는 batch kernel
+	template <typename T>
+	static void updateContacts(ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+							   const ManifoldReuseThreshold &reuseThreshold);
+	template <typename T> bool updateManifold(const ManifoldReuseThreshold &reuseThreshold);
+	// shape type을 고정한 GJK/EPA (support 함수가 inline 됨), Shape이면 virtual 호출
+	template <typename ShapeA, typename ShapeB>
+	void evaluateConvex(Manifold &manifold, const Transform &transformA, const Transform &transformB);
+	template <typename ShapeA, typename ShapeB>
+	Simplex getSupportPoint(const ConvexInfo &convexA, const ConvexInfo &convexB, const glm::vec3 &dir);
+	template <typename ShapeT> glm::vec3 support(const ConvexInfo &convex, const glm::vec3 &dir);
+	template <typename ShapeA, typename ShapeB>
+	bool getGjkResult(const ConvexInfo &convexA, const ConvexInfo &convexB, SimplexArray &simplexArray);
+	template <typename ShapeA, typename ShapeB>
+	EpaInfo getEpaResult(const ConvexInfo &convexA, const ConvexInfo &convexB, SimplexArray &simplexArray);
 
+	bool reuseManifold(const ManifoldReuseThreshold &reuseThreshold, const Transform &transformA,
+					   const Transform &transformB);
+	void saveManifoldCache(const ManifoldReuseThreshold &reuseThreshold, const Transform &transformA,
+						   const Transform &transformB);
+	bool finishManifold(const ManifoldReuseThreshold &reuseThreshold, const ManifoldPoint *oldPoints,
+						int32_t oldPointsCount, const Transform &transformA, const Transform &transformB);
 	bool handleLineSimplex(SimplexArray &simplexArray, glm::vec3 &dir);
 	bool handleTriangleSimplex(SimplexArray &simplexArray, glm::vec3 &dir);
 	bool handleTetrahedronSimplex(SimplexArray &simplexArray, glm::vec3 &dir);
 	bool handleSimplex(SimplexArray &simplexArray, glm::vec3 &dir);
-	bool getGjkResult(const ConvexInfo &convexA, const ConvexInfo &convexB, SimplexArray &simplexArray);
 	bool checkSphereToSphereCollide(const ConvexInfo &convexA, const ConvexInfo &convexB);
+	bool checkBoxToBoxCollide(const ConvexInfo &convexA, const ConvexInfo &convexB);
 	bool isDuplicatedPoint(const SimplexArray &simplexArray, const glm::vec3 &supportPoint);
 	bool isSameDirection(glm::vec3 v1, glm::vec3 v2);
 	bool isSimilarDirection(glm::vec3 v1, glm::vec3 v2);
-	void addIfUniqueEdge(UniqueEdges &uniqueEdges, const int32_t *faces, int32_t p1, int32_t p2);
+	bool addEpaFace(EpaArena &arena, const SimplexArray &simplexArray, const glm::vec3 &center, int32_t idx1,
+					int32_t idx2, int32_t idx3);
+	void removeEpaFace(EpaArena &arena, int32_t faceIdx);
+	void siftUpEpaHeap(EpaArena &arena, int32_t heapIdx);
+	void siftDownEpaHeap(EpaArena &arena, int32_t heapIdx);
+	void addHorizonEdge(EpaArena &arena, int32_t p1, int32_t p2);
 
-	virtual glm::vec3 supportA(const ConvexInfo &convexA, glm::vec3 dir) = 0;
-	virtual glm::vec3 supportB(const ConvexInfo &convexB, glm::vec3 dir) = 0;
 	virtual void findCollisionPoints(const ConvexInfo &convexA, const ConvexInfo &convexB, CollisionInfo &collisionInfo,
 									 EpaInfo &epaInfo, SimplexArray &simplexArray) = 0;
 
@@ -177,13 +280,19 @@ class Contact
 	void setBoxFace(Face &face, const ConvexInfo &box, const glm::vec3 &normal);
 	void setCylinderFace(Face &face, const ConvexInfo &cylinder, const glm::vec3 &normal);
 	void setCapsuleFace(Face &face, const ConvexInfo &capsule, const glm::vec3 &normal);
+	void setSideFace(Face &face, const ConvexInfo &convex, const glm::vec3 &normal);
 
 	bool isCollideToHemisphere(const ConvexInfo &capsule, const glm::vec3 &dir);
 
-	void addFaceInFaceArray(FaceArray &faceArray, int32_t idx1, int32_t idx2, int32_t idx3);
-	void mergeFaceArray(FaceArray &faceArray, FaceArray &newFaceArray);
-	void sizeUpFaceArray(FaceArray &faceArray, int32_t newMaxCount);
-	void freeConvexInfo(ConvexInfo &convexA, ConvexInfo &convexB);
+	bool setSphereContact(ManifoldPoint &manifoldPoint, const glm::vec3 &centerA, float radiusA,
+						  const glm::vec3 &centerB, float radiusB);
+	static void computeSphereContacts(SphereBatch &batch);
+	bool applySphereContact(const ManifoldReuseThreshold &reuseThreshold, const SphereBatch &batch, int32_t lane,
+							uint32_t id);
+	int32_t reduceManifoldPoints(ManifoldPoint *points, int32_t pointsCount, const glm::vec3 &normal);
+
+	uint32_t getFaceFeature(const Transform &transform, const glm::vec3 &normal);
+	uint32_t getPointFeature(const Transform &transform, const glm::vec3 &center, const glm::vec3 &point);
 
 	float m_friction;
 	float m_restitution;
@@ -197,6 +306,9 @@ class Contact
 	int32_t m_indexA;
 	int32_t m_indexB;
 	Manifold m_manifold;
+	ManifoldCache m_manifoldCache;
+	glm::vec3 m_cachedAxis; // 마지막 GJK 분리축 또는 EPA normal (A local)
+	bool m_hasCachedAxis;
 };
 } // namespace ale
 
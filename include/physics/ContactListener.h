@@ -0,0 +1,27 @@
+#ifndef CONTACTLISTENER_H
+#define CONTACTLISTENER_H
+
+namespace ale
+{
+
+class Contact;
+
+// 충돌 시작 / 종료 이벤트를 받는 인터페이스
+// narrowphase가 끝난 뒤 한 스레드에서 contact list 순서대로 호출됨
+class ContactListener
+{
+  public:
+	virtual ~ContactListener() = default;
+
+	virtual void beginContact(Contact * /*contact*/)
+	{
+	}
+
+	virtual void endContact(Contact * /*contact*/)
+	{
+	}
+};
+
+} // namespace ale
+
+#endif
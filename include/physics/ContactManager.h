@@ -3,6 +3,8 @@
 
 #include "BroadPhase.h"
 #include "Contact.h"
+#include "ContactListener.h"
+#include "TaskScheduler.h"
 
 namespace ale
 {
@@ -15,10 +17,27 @@ class ContactManager
 	void findNewContacts();
 	bool isSameContact(ContactLink *link, Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
 	void collide();
+	void destroy(Contact *contact);
+	void setTaskScheduler(TaskScheduler *scheduler);
+	// 상대 이동, 회전이 threshold 이하이면 manifold를 다시 계산하지 않고 재사용 (0이면 항상 재계산)
+	// 기본값은 0, 재사용 중에는 threshold 이하의 접선 방향 미끄러짐이 manifold에 반영되지 않아 쌓인 물체가 덜 안정적
+	void setManifoldReuseThreshold(float linearThreshold, float angularThreshold);
+
+	static const int32_t COLLIDE_CHUNK_SIZE;
 
 	BroadPhase m_broadPhase;
 	Contact *m_contactList;
 	int32_t m_contactCount;
+	ContactListener *m_contactListener;
+
+  private:
+	void updateContacts(int32_t begin, int32_t end);
+	void commitContacts();
+
+	TaskScheduler *m_taskScheduler;
+	std::vector<ContactUpdate> m_contactUpdates;
+	std::vector<int32_t> m_updateOrder; // pair type별로 정렬된 m_contactUpdates index
+	ManifoldReuseThreshold m_reuseThreshold;
 };
 
 } // namespace ale
@@ -3,10 +3,15 @@
 
 #include "Island.h"
 #include "PhysicsAllocator.h"
+#include "TaskScheduler.h"
 
 namespace ale
 {
 
+// body마다 64bit mask로 사용 중인 color를 기록, 64개를 넘으면 overflow color에 모아 한 스레드에서 처리
+const int32_t MAX_COLOR_COUNT = 64;
+const int32_t OVERFLOW_COLOR = MAX_COLOR_COUNT;
+
 struct ContactPositionConstraint
 {
 	ManifoldPoint *points;
@@ -39,18 +44,29 @@ struct ContactVelocityConstraint
 class ContactSolver
 {
   public:
-	ContactSolver(float duration, Contact **contacts, Position *positions, Velocity *velocities, int32_t bodyCount,
-				  int32_t contactCount);
+	ContactSolver(float duration, Contact **contacts, ContactBodyIndex *contactIndices, Position *positions,
+				  Velocity *velocities, int32_t bodyCount, int32_t contactCount, StackAllocator &allocator);
 	void destroy();
 	void initializeVelocityConstraints();
+	void warmStart();
 	void solveVelocityConstraints();
 	void solvePositionConstraints();
 	void checkSleepContact();
 
+	// 같은 dynamic body를 공유하지 않는 contact끼리 같은 color로 묶고
+	// color 단위로 나눠서 scheduler의 worker들이 동시에 처리
+	void colorConstraints();
+	void warmStart(TaskScheduler &scheduler);
+	void solveVelocityConstraints(TaskScheduler &scheduler);
+	void solvePositionConstraints(TaskScheduler &scheduler);
+
 	static const float NORMAL_STOP_VELOCITY;
 	static const float TANGENT_STOP_VELOCITY;
 	static const float NORMAL_SLEEP_VELOCITY;
 	static const float TANGENT_SLEEP_VELOCITY;
+	static const float RESTITUTION_VELOCITY;
+	static const int32_t COLOR_CHUNK_SIZE;
+	static const int32_t MIN_PARALLEL_COLOR_SIZE;
 
 	int32_t m_bodyCount;
 	int32_t m_contactCount;
@@ -60,6 +76,17 @@ class ContactSolver
 	Velocity *m_velocities;
 	ContactPositionConstraint *m_positionConstraints;
 	ContactVelocityConstraint *m_velocityConstraints;
+	StackAllocator &m_allocator;
+
+	// color별 contact index, color c의 contact는 m_colorContacts[m_colorOffsets[c] ~ m_colorOffsets[c + 1])
+	int32_t *m_colorContacts;
+	int32_t m_colorOffsets[MAX_COLOR_COUNT + 2];
+
+  private:
+	void warmStartConstraint(int32_t i);
+	void solveVelocityConstraint(int32_t i);
+	void solvePositionConstraint(int32_t i);
+	template <typename F> void solveColors(TaskScheduler &scheduler, F solveConstraint);
 };
 
 } // namespace ale
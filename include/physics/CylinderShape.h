@@ -15,18 +15,31 @@ class CylinderShape : public Shape
 	CylinderShape *clone() const;
 	int32_t getChildCount() const;
 	void computeAABB(AABB *aabb, const Transform &xf) const;
-	void setShapeFeatures(const std::vector<Vertex> &vertices);
+	void setShapeFeatures(const std::vector<glm::vec3> &positions);
 	// void findAxisByLongestPair(const std::vector<Vertex> &vertices);
 	// void computeCylinderRadius(const std::vector<Vertex> &vertices);
-	void computeCylinderFeatures(const std::vector<Vertex> &vertices);
-	void createCylinderPoints();
+	void computeCylinderFeatures(const std::vector<glm::vec3> &positions);
 	
 	virtual ConvexInfo getShapeInfo(const Transform &transform) const override;
+	// 축 방향으로 윗면/아랫면을 고르고, 축에 수직인 방향으로 radius만큼 이동
+	virtual glm::vec3 getSupportPoint(const glm::vec3 &dir) const override final
+	{
+		float dotResult = glm::dot(dir, m_axes[0]);
+		glm::vec3 point = m_center + m_axes[0] * (dotResult < 0.0f ? -0.5f : 0.5f) * m_height;
+
+		glm::vec3 circleDir = dir - dotResult * m_axes[0];
+		float length2 = glm::length2(circleDir);
+		if (length2 > 1e-8f)
+		{
+			point += circleDir * (m_radius / std::sqrt(length2));
+		}
+
+		return point;
+	}
 
 	float m_radius;
 	float m_height;
-	glm::vec3 m_axes[21];
-	glm::vec3 m_points[40];
+	glm::vec3 m_axes[3];
 	std::set<glm::vec3, Vec3Comparator> m_vertices;
 };
 } // namespace ale
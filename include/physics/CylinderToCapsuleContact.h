@@ -10,10 +10,10 @@ class CylinderToCapsuleContact : public Contact
 {
   public:
 	static Contact *create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
+	static void destroy(Contact *contact);
 	CylinderToCapsuleContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
 
-	virtual glm::vec3 supportA(const ConvexInfo &cylinder, glm::vec3 dir) override;
-	virtual glm::vec3 supportB(const ConvexInfo &capsule, glm::vec3 dir) override;
+	virtual void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB) override;
 	virtual void findCollisionPoints(const ConvexInfo &cylinder, const ConvexInfo &capsule,
 									 CollisionInfo &collisionInfo, EpaInfo &epaInfo,
 									 SimplexArray &simplexArray) override;
@@ -2,13 +2,67 @@
 #define DYNAMICTREE_H
 
 #include "Collision.h"
-#include "Common.h"
+#include "physics/PhysicsCommon.h"
 #include <stack>
 
 #define nullNode (-1)
 
 namespace ale
 {
+// binned SAH rebuild에서 축 하나를 나누는 bin 개수
+const int32_t SAH_BIN_COUNT = 12;
+
+// rebuildBottomUp에서 Morton 순서로 앞뒤 몇 개의 node까지 짝 후보로 볼지
+const int32_t BOTTOM_UP_SEARCH_RADIUS = 16;
+
+// query가 heap 할당 없이 쓰는 stack 크기, 넘치면 vector로 옮겨서 계속 진행
+const int32_t QUERY_STACK_SIZE = 256;
+
+// tree query용 node stack
+// 평소에는 on-stack 배열을 쓰고 QUERY_STACK_SIZE를 넘으면 heap 배열로 옮김
+class QueryStack
+{
+  public:
+	QueryStack() : m_stack(m_fixedStack), m_capacity(QUERY_STACK_SIZE), m_count(0)
+	{
+	}
+
+	QueryStack(const QueryStack &) = delete;
+	QueryStack &operator=(const QueryStack &) = delete;
+
+	void push(int32_t nodeId)
+	{
+		if (m_count == m_capacity)
+		{
+			if (m_stack == m_fixedStack)
+			{
+				m_overflowStack.assign(m_fixedStack, m_fixedStack + m_count);
+			}
+			m_capacity *= 2;
+			m_overflowStack.resize(m_capacity);
+			m_stack = m_overflowStack.data();
+		}
+		m_stack[m_count++] = nodeId;
+	}
+
+	int32_t pop()
+	{
+		return m_stack[--m_count];
+	}
+
+	bool isEmpty() const
+	{
+		return m_count == 0;
+	}
+
+  private:
+	int32_t m_fixedStack[QUERY_STACK_SIZE];
+	std::vector<int32_t> m_overflowStack;
+	int32_t *m_stack;
+	int32_t m_capacity;
+	int32_t m_count;
+};
+
 struct TreeNode
 {
 	bool isLeaf() const
@@ -42,6 +96,13 @@ class DynamicTree
 	// proxyId에 해당하는 node 삭제 후, 적당한 위치로 다시 Insert
 	bool moveProxy(int32_t proxyId, const AABB &aabb, const glm::vec3 &displacement);
 
+	// moveProxy와 같은 조건으로 fat AABB만 새로 잡고 구조는 그대로 둠
+	// 조상 node의 aabb는 다음 refit에서 한 번에 갱신
+	bool enlargeProxy(int32_t proxyId, const AABB &aabb, const glm::vec3 &displacement);
+
+	// enlargeProxy로 바뀐 leaf의 조상 aabb를 높이 순서로 아래에서부터 다시 계산
+	void refit();
+
 	//
 	void *getUserData(int32_t proxyId) const;
 
@@ -50,7 +111,36 @@ class DynamicTree
 
 	template <typename T> void query(T *callback, const AABB &aabb) const;
 
+	// query를 바꾸기 전의 traversal (std::stack, node를 값으로 복사)
+	// ale_tree_benchmark에서 같은 tree로 처리량을 비교하는 용도로만 사용
+	template <typename T> void queryWithStdStack(T *callback, const AABB &aabb) const;
+
+	// leaf는 그대로 두고 internal node를 binned SAH로 위에서부터 다시 만듦
+	// proxyId는 바뀌지 않음, 한 번 만들고 거의 바뀌지 않는 static tree용
+	void rebuild();
+
+	// leaf는 그대로 두고 Morton 순서에서 가까운 node끼리 표면적이 작은 쌍을 반복해서 묶어 아래에서부터 다시 만듦
+	// pass 한 번이 O(n * BOTTOM_UP_SEARCH_RADIUS), 보통 pass마다 node 수가 절반 가까이 줄어듦
+	// rebuild보다 2~3배 느리고 SAH 비용도 보통 더 높음
+	// 매 step 호출하지 말고 load 시점이나 tree 품질 비교에만 사용
+	void rebuildBottomUp();
+
+	// 최대 budget개의 internal node에서 자식과 손자를 바꾸는 회전으로 SAH 비용을 줄임
+	// 회전 직후의 비용만 줄어들고 이후 reinsert / refit은 바뀐 구조 위에서 더 나쁜 tree를 만듦
+	// (ale_tree_benchmark 10000 proxy, budget 64에서 churn보다 SAH 비용 29% 증가) 그래서 BroadPhase는 호출하지 않음
+	// 실제로 회전한 횟수 반환
+	int32_t rotate(int32_t budget);
+
+	// tree 품질 - internal node 표면적의 합 (SAH 비용)과 root 높이
+	float getTotalCost() const;
+	int32_t getHeight() const;
+
+	// leaf 삽입 / 삭제로 구조가 바뀔 때마다 증가, WideTree가 다시 build할지 판단하는 데 사용
+	uint32_t getVersion() const;
+
   private:
+	friend class WideTree;
+
 	int32_t allocateNode();
 	void freeNode(int32_t nodeId);
 
@@ -63,6 +153,21 @@ class DynamicTree
 	// 트리가 쏠리지 않게 balance 맞춰줌
 	int32_t balance(int32_t index);
 
+	// 움직인 aabb에 margin과 이동 방향으로 2배 displacement를 더한 fat AABB
+	AABB computeFatAABB(const AABB &aabb, const glm::vec3 &displacement) const;
+
+	// leaf nodeId를 모으고 internal node는 모두 반환
+	void collectLeaves(std::vector<int32_t> &leaves);
+
+	// leaves[0, count)로 subtree를 만들고 root nodeId 반환
+	int32_t buildSubtree(int32_t *leaves, int32_t count);
+
+	// child1, child2를 자식으로 갖는 internal node 생성
+	int32_t createParent(int32_t child1, int32_t child2);
+
+	// nodeId의 자식 swapOut과 다른 자식 inner의 자식 swapIn을 맞바꿈
+	void rotateNodes(int32_t nodeId, int32_t swapOut, int32_t inner, int32_t swapIn);
+
 	float getInsertionCostForLeaf(const AABB &leafAABB, int32_t child, float inheritedCost);
 
 	float getInsertionCost(const AABB &leafAABB, int32_t child, float inheritedCost);
@@ -78,12 +183,68 @@ class DynamicTree
 	int32_t m_freeNode;
 	int32_t m_nodeCount;
 	int32_t m_nodeCapacity;
+	uint32_t m_version;
+	int32_t m_rotateCursor; // rotate가 다음에 검사할 node index
+
+	std::vector<int32_t> m_refitLeaves; // 다음 refit에서 조상을 갱신할 leaf
+	std::vector<int32_t> m_refitNodes;
+	std::vector<uint8_t> m_refitMarks; // 이번 refit에서 이미 m_refitNodes에 넣은 node
 	std::vector<TreeNode> m_nodes;
 };
 
 template <typename T> inline void DynamicTree::query(T *callback, const AABB &aabb) const
 {
-	// std::cout << "DynamicTree::query\n";
+	if (m_root == nullNode)
+	{
+		return;
+	}
+
+	const TreeNode *nodes = m_nodes.data();
+	if (testOverlap(nodes[m_root].aabb, aabb) == false)
+	{
+		return;
+	}
+	if (nodes[m_root].isLeaf())
+	{
+		callback->queryCallback(m_root);
+		return;
+	}
+
+	// stack에는 aabb가 겹치는 internal node만 들어감
+	QueryStack stack;
+	stack.push(m_root);
+
+	while (stack.isEmpty() == false)
+	{
+		const TreeNode &node = nodes[stack.pop()];
+		int32_t children[2] = {node.child1, node.child2};
+
+		// 두 자식의 aabb를 먼저 검사하고 겹치는 쪽만 내려감
+		for (int32_t i = 0; i < 2; ++i)
+		{
+			int32_t childId = children[i];
+			const TreeNode &child = nodes[childId];
+			if (testOverlap(child.aabb, aabb) == false)
+			{
+				continue;
+			}
+
+			if (child.isLeaf())
+			{
+				bool proceed = callback->queryCallback(childId);
+				if (proceed == false)
+				{
+					return;
+				}
+				continue;
+			}
+			stack.push(childId);
+		}
+	}
+}
+
+template <typename T> inline void DynamicTree::queryWithStdStack(T *callback, const AABB &aabb) const
+{
 	std::stack<int32_t> stack;
 	stack.push(m_root);
 
@@ -91,7 +252,6 @@ template <typename T> inline void DynamicTree::query(T *callback, const AABB &aa
 	{
 		int32_t nodeId = stack.top();
 		stack.pop();
-		// std::cout << "nodeId: " << nodeId << '\n';
 		if (nodeId == nullNode)
 		{
 			continue;
@@ -110,9 +270,7 @@ template <typename T> inline void DynamicTree::query(T *callback, const AABB &aa
 			}
 			else
 			{
-				// std::cout << "stack push: " << node.child1 << '\n';
 				stack.push(node.child1);
-				// std::cout << "stack push: " << node.child2 << '\n';
 				stack.push(node.child2);
 			}
 		}
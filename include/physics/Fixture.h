@@ -1,7 +1,7 @@
 #ifndef FIXTURE_H
 #define FIXTURE_H
 
-#include "Common.h"
+#include "physics/PhysicsCommon.h"
 #include "physics/Rigidbody.h"
 #include "physics/PhysicsAllocator.h"
 
@@ -2,6 +2,7 @@
 #define ISLAND_H
 
 #include "Contact.h"
+#include "TaskScheduler.h"
 
 namespace ale
 {
@@ -24,24 +25,34 @@ struct Velocity
 	glm::vec3 angularVelocityBuffer;
 };
 
+// island 내부에서의 contact 양쪽 body 인덱스
+// static body는 여러 island에 동시에 속하므로 body의 islandIndex 대신 island 생성 시점에 기록해 둔다
+struct ContactBodyIndex
+{
+	int32_t indexA;
+	int32_t indexB;
+};
+
 class Island
 {
   public:
-	Island(int32_t bodyCount, int32_t contactCount);
-	void solve(float duration);
-	void destroy();
+	Island(Rigidbody **bodies, Contact **contacts, ContactBodyIndex *contactIndices);
+	void solve(float duration, StackAllocator &allocator, TaskScheduler *scheduler);
+	void synchronizeFixtures();
 
 	void add(Rigidbody *body);
 	void add(Contact *contact);
-	void clear();
+	void storeContactIndices();
 
 	static const int32_t VELOCITY_ITERATION;
 	static const int32_t POSITION_ITERATION;
 	static const float STOP_LINEAR_VELOCITY;
 	static const float STOP_ANGULAR_VELOCITY;
+	static const int32_t PARALLEL_SOLVE_CONTACT_COUNT;
 
 	Rigidbody **m_bodies;
 	Contact **m_contacts;
+	ContactBodyIndex *m_contactIndices;
 	Position *m_positions;
 	Velocity *m_velocities;
 
@@ -80,6 +80,7 @@ class Rigidbody
 	void addForceAtBodyPoint(const glm::vec3 &force, const glm::vec3 &point);
 	void clearAccumulators();
 	void synchronizeFixtures();
+	void destroyProxies();
 	void calculateDerivedData();
 	void calculateForceAccum();
 
@@ -1,7 +1,6 @@
 #ifndef SHAPE_H
 #define SHAPE_H
 
-#include "Vertex.h"
 #include "physics/Collision.h"
 #include <algorithm>
 
@@ -41,6 +40,8 @@ class Shape
 	virtual int32_t getChildCount() const = 0;
 	virtual void computeAABB(AABB *aabb, const Transform &xf) const = 0;
 	virtual ConvexInfo getShapeInfo(const Transform &transform) const = 0;
+	// local space 방향 dir에 대해 가장 멀리 있는 local space 점
+	virtual glm::vec3 getSupportPoint(const glm::vec3 &dir) const = 0;
 
 	EType getType() const
 	{
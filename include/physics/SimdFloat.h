@@ -0,0 +1,297 @@
+#ifndef SIMDFLOAT_H
+#define SIMDFLOAT_H
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ALE_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ALE_SIMD_SSE
+#endif
+
+namespace ale
+{
+
+// SoA batch kernel에서 한 번에 처리하는 float lane 묶음
+// AVX는 8개, SSE는 4개, 둘 다 없으면 1개씩 처리
+// 비교 결과는 lane마다 모든 bit가 1(참) 또는 0(거짓)인 mask
+#if defined(ALE_SIMD_AVX)
+
+const int32_t SIMD_WIDTH = 8;
+
+struct SimdFloat
+{
+	__m256 value;
+};
+
+inline SimdFloat simdLoad(const float *p)
+{
+	return {_mm256_loadu_ps(p)};
+}
+
+inline SimdFloat simdSet(float v)
+{
+	return {_mm256_set1_ps(v)};
+}
+
+inline void simdStore(float *p, SimdFloat a)
+{
+	_mm256_storeu_ps(p, a.value);
+}
+
+inline SimdFloat operator+(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_add_ps(a.value, b.value)};
+}
+
+inline SimdFloat operator-(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_sub_ps(a.value, b.value)};
+}
+
+inline SimdFloat operator*(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_mul_ps(a.value, b.value)};
+}
+
+inline SimdFloat operator/(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_div_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_min_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_max_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdSqrt(SimdFloat a)
+{
+	return {_mm256_sqrt_ps(a.value)};
+}
+
+inline SimdFloat simdLess(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ)};
+}
+
+inline SimdFloat simdLessEqual(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_cmp_ps(a.value, b.value, _CMP_LE_OQ)};
+}
+
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_and_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b)
+{
+	return {_mm256_or_ps(a.value, b.value)};
+}
+
+// mask가 참인 lane은 a, 거짓인 lane은 b
+inline SimdFloat simdSelect(SimdFloat mask, SimdFloat a, SimdFloat b)
+{
+	return {_mm256_blendv_ps(b.value, a.value, mask.value)};
+}
+
+// lane i의 mask가 참이면 i번째 bit가 1
+inline int32_t simdMoveMask(SimdFloat mask)
+{
+	return _mm256_movemask_ps(mask.value);
+}
+
+#elif defined(ALE_SIMD_SSE)
+
+const int32_t SIMD_WIDTH = 4;
+
+struct SimdFloat
+{
+	__m128 value;
+};
+
+inline SimdFloat simdLoad(const float *p)
+{
+	return {_mm_loadu_ps(p)};
+}
+
+inline SimdFloat simdSet(float v)
+{
+	return {_mm_set1_ps(v)};
+}
+
+inline void simdStore(float *p, SimdFloat a)
+{
+	_mm_storeu_ps(p, a.value);
+}
+
+inline SimdFloat operator+(SimdFloat a, SimdFloat b)
+{
+	return {_mm_add_ps(a.value, b.value)};
+}
+
+inline SimdFloat operator-(SimdFloat a, SimdFloat b)
+{
+	return {_mm_sub_ps(a.value, b.value)};
+}
+
+inline SimdFloat operator*(SimdFloat a, SimdFloat b)
+{
+	return {_mm_mul_ps(a.value, b.value)};
+}
+
+inline SimdFloat operator/(SimdFloat a, SimdFloat b)
+{
+	return {_mm_div_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b)
+{
+	return {_mm_min_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b)
+{
+	return {_mm_max_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdSqrt(SimdFloat a)
+{
+	return {_mm_sqrt_ps(a.value)};
+}
+
+inline SimdFloat simdLess(SimdFloat a, SimdFloat b)
+{
+	return {_mm_cmplt_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdLessEqual(SimdFloat a, SimdFloat b)
+{
+	return {_mm_cmple_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b)
+{
+	return {_mm_and_ps(a.value, b.value)};
+}
+
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b)
+{
+	return {_mm_or_ps(a.value, b.value)};
+}
+
+// mask가 참인 lane은 a, 거짓인 lane은 b
+inline SimdFloat simdSelect(SimdFloat mask, SimdFloat a, SimdFloat b)
+{
+	return {_mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value))};
+}
+
+// lane i의 mask가 참이면 i번째 bit가 1
+inline int32_t simdMoveMask(SimdFloat mask)
+{
+	return _mm_movemask_ps(mask.value);
+}
+
+#else
+
+const int32_t SIMD_WIDTH = 1;
+
+struct SimdFloat
+{
+	float value;
+};
+
+inline SimdFloat simdLoad(const float *p)
+{
+	return {*p};
+}
+
+inline SimdFloat simdSet(float v)
+{
+	return {v};
+}
+
+inline void simdStore(float *p, SimdFloat a)
+{
+	*p = a.value;
+}
+
+inline SimdFloat operator+(SimdFloat a, SimdFloat b)
+{
+	return {a.value + b.value};
+}
+
+inline SimdFloat operator-(SimdFloat a, SimdFloat b)
+{
+	return {a.value - b.value};
+}
+
+inline SimdFloat operator*(SimdFloat a, SimdFloat b)
+{
+	return {a.value * b.value};
+}
+
+inline SimdFloat operator/(SimdFloat a, SimdFloat b)
+{
+	return {a.value / b.value};
+}
+
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b)
+{
+	return {a.value < b.value ? a.value : b.value};
+}
+
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b)
+{
+	return {a.value > b.value ? a.value : b.value};
+}
+
+inline SimdFloat simdSqrt(SimdFloat a)
+{
+	return {std::sqrt(a.value)};
+}
+
+// scalar에서는 참을 1, 거짓을 0으로 표현
+inline SimdFloat simdLess(SimdFloat a, SimdFloat b)
+{
+	return {a.value < b.value ? 1.0f : 0.0f};
+}
+
+inline SimdFloat simdLessEqual(SimdFloat a, SimdFloat b)
+{
+	return {a.value <= b.value ? 1.0f : 0.0f};
+}
+
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b)
+{
+	return {(a.value != 0.0f && b.value != 0.0f) ? 1.0f : 0.0f};
+}
+
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b)
+{
+	return {(a.value != 0.0f || b.value != 0.0f) ? 1.0f : 0.0f};
+}
+
+inline SimdFloat simdSelect(SimdFloat mask, SimdFloat a, SimdFloat b)
+{
+	return {mask.value != 0.0f ? a.value : b.value};
+}
+
+inline int32_t simdMoveMask(SimdFloat mask)
+{
+	return mask.value != 0.0f ? 1 : 0;
+}
+
+#endif
+
+} // namespace ale
+
+#endif
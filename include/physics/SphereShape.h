@@ -15,8 +15,17 @@ class SphereShape : public Shape
 	SphereShape *clone() const;
 	int32_t getChildCount() const;
 	void computeAABB(AABB *aabb, const Transform &xf) const;
-	void setShapeFeatures(std::vector<Vertex> &vertices);
+	void setShapeFeatures(const std::vector<glm::vec3> &positions);
 	virtual ConvexInfo getShapeInfo(const Transform &transform) const override;
+	virtual glm::vec3 getSupportPoint(const glm::vec3 &dir) const override final
+	{
+		float length2 = glm::length2(dir);
+		if (length2 < 1e-12f)
+		{
+			return m_center;
+		}
+		return m_center + dir * (m_radius / std::sqrt(length2));
+	}
 
 	float m_radius;
 };
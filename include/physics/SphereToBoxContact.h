@@ -5,16 +5,38 @@
 
 namespace ale
 {
+
+// sphere batch와 같은 lane 순서로 모은 box의 OBB와 box 위 최근접점의 feature
+struct SphereBoxBatch
+{
+	float centerX[SPHERE_BATCH_SIZE];
+	float centerY[SPHERE_BATCH_SIZE];
+	float centerZ[SPHERE_BATCH_SIZE];
+	float axisX[3][SPHERE_BATCH_SIZE];
+	float axisY[3][SPHERE_BATCH_SIZE];
+	float axisZ[3][SPHERE_BATCH_SIZE];
+	float halfSize[3][SPHERE_BATCH_SIZE];
+
+	float feature[SPHERE_BATCH_SIZE];
+	bool isInside[SPHERE_BATCH_SIZE];
+};
+
 class SphereToBoxContact : public Contact
 {
   public:
 	static Contact *create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
+	static void destroy(Contact *contact);
+	static void updateContacts(ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+							   const ManifoldReuseThreshold &reuseThreshold);
 	SphereToBoxContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
 
-	virtual glm::vec3 supportA(const ConvexInfo &sphere, glm::vec3 dir) override;
-	virtual glm::vec3 supportB(const ConvexInfo &box, glm::vec3 dir) override;
+	virtual void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB) override;
 	virtual void findCollisionPoints(const ConvexInfo &sphere, const ConvexInfo &box, CollisionInfo &collisionInfo,
 									 EpaInfo &epaInfo, SimplexArray &simplexArray) override;
+
+  private:
+	static void computeClosestPoints(SphereBatch &batch, SphereBoxBatch &boxBatch);
+	bool updateInsideManifold(const ManifoldReuseThreshold &reuseThreshold);
 };
 } // namespace ale
 
@@ -9,10 +9,12 @@ class SphereToSphereContact : public Contact
 {
   public:
 	static Contact *create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
+	static void destroy(Contact *contact);
+	static void updateContacts(ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+							   const ManifoldReuseThreshold &reuseThreshold);
 	SphereToSphereContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB);
 
-	virtual glm::vec3 supportA(const ConvexInfo &sphere, glm::vec3 dir) override;
-	virtual glm::vec3 supportB(const ConvexInfo &sphere, glm::vec3 dir) override;
+	virtual void evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB) override;
 	virtual void findCollisionPoints(const ConvexInfo &sphereA, const ConvexInfo &sphereB, CollisionInfo &collisionInfo,
 									 EpaInfo &epaInfo, SimplexArray &simplexArray) override;
 };
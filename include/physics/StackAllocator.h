@@ -1,7 +1,7 @@
 #ifndef STACKALLOCATOR_H
 #define STACKALLOCATOR_H
 
-#include "common.h"
+#include "physics/PhysicsCommon.h"
 
 namespace ale
 {
@@ -0,0 +1,29 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include "physics/PhysicsCommon.h"
+#include <functional>
+
+namespace ale
+{
+
+// task(index, workerIndex) - workerIndex는 [0, getWorkerCount()) 범위
+using TaskFunction = std::function<void(int32_t, int32_t)>;
+
+// 물리엔진이 병렬 작업을 맡기는 인터페이스
+// 호스트 엔진이 자체 job system을 쓰려면 이 클래스를 상속해 World::setTaskScheduler로 등록
+class TaskScheduler
+{
+  public:
+	virtual ~TaskScheduler() = default;
+
+	virtual int32_t getWorkerCount() const = 0;
+
+	// [0, count)의 task를 실행하고 모두 끝날 때까지 반환하지 않음
+	// 같은 workerIndex를 가진 task는 동시에 실행되지 않아야 함
+	virtual void parallelFor(int32_t count, const TaskFunction &task) = 0;
+};
+
+} // namespace ale
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "physics/TaskScheduler.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace ale
+{
+
+// 기본 TaskScheduler 구현 - work stealing thread pool
+// 호출 스레드가 worker 0으로 참여하고, 나머지 worker는 별도 스레드
+class ThreadPool : public TaskScheduler
+{
+  public:
+	// workerCount가 0이면 하드웨어 스레드 수 사용
+	explicit ThreadPool(int32_t workerCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	int32_t getWorkerCount() const override;
+	void parallelFor(int32_t count, const TaskFunction &task) override;
+
+  private:
+	// 각 worker가 처리할 task index 구간 [begin, end)
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		int32_t begin;
+		int32_t end;
+	};
+
+	void workerLoop(int32_t workerIndex);
+	void runTasks(int32_t workerIndex);
+	bool popTask(int32_t workerIndex, int32_t &index);
+	bool stealTasks(int32_t workerIndex);
+
+	int32_t m_workerCount;
+	std::vector<std::thread> m_threads;
+	std::unique_ptr<WorkQueue[]> m_queues;
+
+	std::mutex m_mutex;
+	std::condition_variable m_startCondition;
+	std::condition_variable m_finishCondition;
+	const TaskFunction *m_task;
+	std::exception_ptr m_exception;
+	int64_t m_generation;
+	int32_t m_activeWorkers;
+	bool m_stop;
+};
+
+} // namespace ale
+
+#endif
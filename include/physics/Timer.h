@@ -0,0 +1,35 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <chrono>
+
+namespace ale
+{
+
+// 물리 단계별 소요 시간 측정용 타이머
+class Timer
+{
+  public:
+	Timer()
+	{
+		reset();
+	}
+
+	void reset()
+	{
+		m_start = std::chrono::steady_clock::now();
+	}
+
+	float getMilliseconds() const
+	{
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+		return elapsed.count();
+	}
+
+  private:
+	std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace ale
+
+#endif
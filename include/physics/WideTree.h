@@ -0,0 +1,115 @@
+#ifndef WIDETREE_H
+#define WIDETREE_H
+
+#include "physics/DynamicTree.h"
+#include "physics/SimdFloat.h"
+#include <utility>
+
+namespace ale
+{
+const int32_t WIDE_NODE_WIDTH = 4;
+
+// 자식 4개의 bounds를 축별로 모아둔 node
+// bounds[axis]의 앞 4칸은 자식의 min, 뒤 4칸은 부호를 뒤집은 max
+// 빈 slot은 FLT_MAX로 채워 어떤 aabb와도 겹치지 않게 함
+struct WideNode
+{
+	float bounds[3][2 * WIDE_NODE_WIDTH];
+	int32_t children[WIDE_NODE_WIDTH]; // leafMask bit가 켜진 slot은 DynamicTree proxyId, 아니면 WideNode index
+	int32_t leafMask;
+};
+
+// DynamicTree를 4갈래로 펼친 query 전용 BVH
+// aabb, 자식 index만 들고 있어서 traversal 중에 userData, parent, height를 읽지 않음
+// DynamicTree 구조가 바뀌면 update에서 다시 build
+class WideTree
+{
+  public:
+	WideTree();
+
+	// tree의 version이 바뀌었을 때만 다시 build
+	void update(const DynamicTree &tree);
+
+	void build(const DynamicTree &tree);
+
+	// DynamicTree::query와 같은 callback, proxyId는 원래 tree의 proxyId
+	template <typename T> void query(T *callback, const AABB &aabb) const;
+
+	int32_t getNodeCount() const;
+
+  private:
+	void setSlot(int32_t wideId, int32_t slot, const AABB &aabb, int32_t child, bool isLeaf);
+
+	// query bounds와 4개 자식 bounds를 비교해 겹치는 slot의 bit를 켠 mask 반환
+	static int32_t getOverlapMask(const WideNode &node, const float (&queryBounds)[3][2 * WIDE_NODE_WIDTH]);
+
+	std::vector<WideNode> m_nodes;
+	std::vector<std::pair<int32_t, int32_t>> m_buildStack; // (DynamicTree node, WideNode index)
+	uint32_t m_treeVersion;
+	bool m_isBuilt;
+};
+
+inline int32_t WideTree::getOverlapMask(const WideNode &node, const float (&queryBounds)[3][2 * WIDE_NODE_WIDTH])
+{
+	// child min <= query max, -child max <= -query min 을 축마다 한 번에 비교
+	// AVX는 축당 1번, SSE는 축당 2번 비교
+	int32_t mask = 0;
+	for (int32_t lane = 0; lane < 2 * WIDE_NODE_WIDTH; lane += SIMD_WIDTH)
+	{
+		SimdFloat x = simdLessEqual(simdLoad(node.bounds[0] + lane), simdLoad(queryBounds[0] + lane));
+		SimdFloat y = simdLessEqual(simdLoad(node.bounds[1] + lane), simdLoad(queryBounds[1] + lane));
+		SimdFloat z = simdLessEqual(simdLoad(node.bounds[2] + lane), simdLoad(queryBounds[2] + lane));
+		mask |= simdMoveMask(simdAnd(simdAnd(x, y), z)) << lane;
+	}
+	return mask & (mask >> WIDE_NODE_WIDTH) & ((1 << WIDE_NODE_WIDTH) - 1);
+}
+
+template <typename T> inline void WideTree::query(T *callback, const AABB &aabb) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	float queryBounds[3][2 * WIDE_NODE_WIDTH];
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		for (int32_t i = 0; i < WIDE_NODE_WIDTH; ++i)
+		{
+			queryBounds[axis][i] = aabb.upperBound[axis];
+			queryBounds[axis][WIDE_NODE_WIDTH + i] = -aabb.lowerBound[axis];
+		}
+	}
+
+	const WideNode *nodes = m_nodes.data();
+	QueryStack stack;
+	stack.push(0);
+
+	while (stack.isEmpty() == false)
+	{
+		const WideNode &node = nodes[stack.pop()];
+		int32_t mask = getOverlapMask(node, queryBounds);
+
+		for (int32_t i = 0; mask != 0; ++i, mask >>= 1)
+		{
+			if ((mask & 1) == 0)
+			{
+				continue;
+			}
+
+			if (node.leafMask & (1 << i))
+			{
+				bool proceed = callback->queryCallback(node.children[i]);
+				if (proceed == false)
+				{
+					return;
+				}
+				continue;
+			}
+			stack.push(node.children[i]);
+		}
+	}
+}
+} // namespace ale
+
+#endif
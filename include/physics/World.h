@@ -0,0 +1,72 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "physics/PhysicsCommon.h"
+#include "ContactManager.h"
+#include "Island.h"
+#include "TaskScheduler.h"
+#include "Timer.h"
+#include <stack>
+
+namespace ale
+{
+class Rigidbody;
+class ContactManager;
+class BoxShape;
+class SphereShape;
+
+// runPhysics 한 번에 걸린 단계별 시간 (ms)
+struct Profile
+{
+	float step;
+	float integrate;
+	float broadPhase;
+	float narrowPhase;
+	float solve;
+};
+
+class World
+{
+  public:
+	World();
+	~World();
+
+	void startFrame();
+	void runPhysics(float duration);
+	void solve(float duration);
+	void createBody(Shape *shape, const Transform &xf, int32_t xfId);
+	void createBox(Shape *shape, const Transform &xf, int32_t xfId);
+	void createSphere(Shape *shape, const Transform &xf, int32_t xfId);
+	void createGround(Shape *shape, const Transform &xf, int32_t xfId);
+	void createCylinder(Shape *shape, const Transform &xf, int32_t xfId);
+	void createCapsule(Shape *shape, const Transform &xf, int32_t xfId);
+
+	// body에 연결된 contact, broadphase proxy를 제거하고 fixture, shape, body 메모리 반환
+	void destroyBody(Rigidbody *body);
+	void registerBodyForce(int32_t idx, const glm::vec3 &force);
+
+	// nullptr이면 island를 한 스레드에서 순서대로 solve
+	void setTaskScheduler(TaskScheduler *scheduler);
+	void setContactListener(ContactListener *listener);
+	void setManifoldReuseThreshold(float linearThreshold, float angularThreshold);
+
+	Rigidbody *getBodyList();
+	int32_t getBodyCount() const;
+	const Profile &getProfile() const;
+
+	ContactManager m_contactManager;
+
+  private:
+	void solveIslands(float duration);
+
+	Rigidbody *m_rigidbodies;
+	int32_t m_rigidbodyCount;
+	Profile m_profile;
+
+	TaskScheduler *m_taskScheduler;
+	std::vector<std::unique_ptr<StackAllocator>> m_workerStackAllocators;
+	std::vector<Island> m_islands;
+	std::vector<int32_t> m_smallIslands;
+};
+} // namespace ale
+#endif
@@ -128,7 +128,7 @@ void App::processEvents()
 											 "C:/Users/seonjo/FT_NEWTON/models/sphere.png"));
 		transforms.push_back(sphereXf);
 		int32_t idx = models.size() - 1;
-		world->createBody(models[idx], idx);
+		world->createBody(models[idx]->getShape(), transforms[idx], idx);
 		world->registerBodyForce(idx, cameraFront * 300000.0f);
 
 		models[idx]->createDescriptorSets(device, descriptorPool->get(), renderer->getDescriptorSetLayout());
@@ -199,6 +199,7 @@ void App::mainLoop()
 		// calculate positions
 		world->startFrame();
 		world->runPhysics(duration);
+		updateTransforms();
 		drawFrame();
 		time = glfwGetTime();
 	}
@@ -400,16 +401,27 @@ void App::createModels()
 
 void App::createWorld()
 {
-	world = std::make_unique<ale::World>(*this);
+	world = std::make_unique<ale::World>();
 
 	// std::cout << "App::Create World\n";
 	for (size_t i = 0; i < models.size(); ++i)
 	{
-		world->createBody(models[i], static_cast<int32_t>(i));
+		world->createBody(models[i]->getShape(), transforms[i], static_cast<int32_t>(i));
 	}
 	// std::cout << "App::Create World end\n";
 }
 
+// 물리 시뮬레이션 결과를 렌더링용 transform에 반영
+void App::updateTransforms()
+{
+	ale::Rigidbody *body = world->getBodyList();
+	while (body != nullptr)
+	{
+		setTransformById(body->getTransformId(), body->getTransform());
+		body = body->next;
+	}
+}
+
 bool App::tryPrepareImage(uint32_t *imageIndex)
 {
 	// [이전 GPU 작업 대기]
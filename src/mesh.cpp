@@ -16,6 +16,19 @@ void Mesh::init(DeviceManager *deviceManager, VkCommandPool commandPool, const s
 	uniformBuffer = UniformBuffer::create(deviceManager, sizeof(UniformBufferObject));
 }
 
+// 물리 shape 생성에 필요한 정점 위치만 추출
+std::vector<glm::vec3> Mesh::getPositions(const std::vector<Vertex> &vertices)
+{
+	std::vector<glm::vec3> positions;
+	positions.reserve(vertices.size());
+
+	for (const Vertex &vertex : vertices)
+	{
+		positions.push_back(vertex.position);
+	}
+	return positions;
+}
+
 void Mesh::setMaterial(Material *material)
 {
 	this->material = material;
@@ -243,7 +256,7 @@ std::unique_ptr<Mesh> Mesh::createBox(DeviceManager *deviceManager, VkCommandPoo
 		Vertex{glm::vec3(-0.5f, 0.5f, 0.5f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f, 0.0f)},
 	};
 
-	shape->setVertices(vertices);
+	shape->setVertices(getPositions(vertices));
 
 	std::vector<uint32_t> indices = {
 		0,	2,	1,	2,	0,	3,	4,	5,	6,	6,	7,	4,	8,	9,	10, 10, 11, 8,
@@ -282,7 +295,7 @@ std::unique_ptr<Mesh> Mesh::createSphere(DeviceManager *deviceManager, VkCommand
 		}
 	}
 
-	shape->setShapeFeatures(vertices);
+	shape->setShapeFeatures(getPositions(vertices));
 
 	indices.resize(latiSegmentCount * longiSegmentCount * 6);
 	for (uint32_t i = 0; i < latiSegmentCount; i++)
@@ -339,7 +352,7 @@ std::unique_ptr<Mesh> Mesh::createGround(DeviceManager *deviceManager, VkCommand
 		Vertex{glm::vec3(-100.0f, 0.01f, 100.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f, 0.0f)},
 	};
 
-	shape->setVertices(vertices);
+	shape->setVertices(getPositions(vertices));
 
 	std::vector<uint32_t> indices = {
 		0,	2,	1,	2,	0,	3,	4,	5,	6,	6,	7,	4,	8,	9,	10, 10, 11, 8,
@@ -425,7 +438,7 @@ std::unique_ptr<Mesh> Mesh::createCylinder(DeviceManager *deviceManager, VkComma
 		indices.push_back(top2);
 	}
 
-	shape->setShapeFeatures(vertices);
+	shape->setShapeFeatures(getPositions(vertices));
 
 	return create(deviceManager, commandPool, vertices, indices);
 }
@@ -497,7 +510,7 @@ std::unique_ptr<Mesh> Mesh::createCapsule(DeviceManager *deviceManager, VkComman
 		}
 	}
 
-	shape->setShapeFeatures(vertices);
+	shape->setShapeFeatures(getPositions(vertices));
 
 	return create(deviceManager, commandPool, vertices, indices);
 }
\ No newline at end of file
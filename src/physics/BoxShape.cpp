@@ -22,58 +22,38 @@ int32_t BoxShape::getChildCount() const
 	return 1;
 }
 
+// 회전 행렬의 절댓값에 half size를 곱해 world 축 방향 반지름 계산
 void BoxShape::computeAABB(AABB *aabb, const Transform &xf) const
 {
-	// update vertices
-	std::vector<glm::vec3> vertexVector(m_vertices.begin(), m_vertices.end());
-	glm::mat4 rotationMatrix = glm::toMat4(glm::normalize(xf.orientation));
-	glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), xf.position);
-	glm::mat4 transformMatrix = translationMatrix * rotationMatrix;
+	glm::mat3 rotationMatrix = glm::toMat3(glm::normalize(xf.orientation));
+	glm::vec3 center = xf.position + rotationMatrix * m_center;
 
-	glm::vec3 upper(std::numeric_limits<float>::lowest());
-	glm::vec3 lower(std::numeric_limits<float>::max());
-
-	for (glm::vec3 &vertex : vertexVector)
+	glm::vec3 extent;
+	for (int32_t i = 0; i < 3; ++i)
 	{
-		glm::vec4 v = transformMatrix * glm::vec4(vertex, 1.0f);
-		vertex = glm::vec3(v.x, v.y, v.z);
-
-		upper.x = std::max(upper.x, vertex.x);
-		upper.y = std::max(upper.y, vertex.y);
-		upper.z = std::max(upper.z, vertex.z);
-		lower.x = std::min(lower.x, vertex.x);
-		lower.y = std::min(lower.y, vertex.y);
-		lower.z = std::min(lower.z, vertex.z);
+		extent[i] = std::abs(rotationMatrix[0][i]) * m_halfSize.x + std::abs(rotationMatrix[1][i]) * m_halfSize.y +
+					std::abs(rotationMatrix[2][i]) * m_halfSize.z;
 	}
 
-	// 최적화 여지 있음.
-	// std::sort(vertexVector.begin(), vertexVector.end(), Vec3Comparator());
-
-	// glm::vec3 upper = *std::prev(vertexVector.end());
-	// glm::vec3 lower = *vertexVector.begin();
-
-	// std::cout << "upper: " << upper.x << ", " << upper.y << ", " << upper.z << '\n';
-	// std::cout << "lower: " << lower.x << ", " << lower.y << ", " << lower.z << '\n';
-
-	aabb->upperBound = upper + glm::vec3(0.1f);
-	aabb->lowerBound = lower - glm::vec3(0.1f);
+	aabb->upperBound = center + extent + glm::vec3(0.1f);
+	aabb->lowerBound = center - extent - glm::vec3(0.1f);
 }
 
-void BoxShape::setVertices(const std::vector<Vertex> &vertices)
+void BoxShape::setVertices(const std::vector<glm::vec3> &positions)
 {
 	glm::vec3 maxPos(std::numeric_limits<float>::lowest());
 	glm::vec3 minPos(std::numeric_limits<float>::max());
 
-	for (const Vertex &vertex : vertices)
+	for (const glm::vec3 &position : positions)
 	{
-		maxPos.x = std::max(maxPos.x, vertex.position.x);
-		maxPos.y = std::max(maxPos.y, vertex.position.y);
-		maxPos.z = std::max(maxPos.z, vertex.position.z);
-		minPos.x = std::min(minPos.x, vertex.position.x);
-		minPos.y = std::min(minPos.y, vertex.position.y);
-		minPos.z = std::min(minPos.z, vertex.position.z);
-
-		m_vertices.insert(vertex.position);
+		maxPos.x = std::max(maxPos.x, position.x);
+		maxPos.y = std::max(maxPos.y, position.y);
+		maxPos.z = std::max(maxPos.z, position.z);
+		minPos.x = std::min(minPos.x, position.x);
+		minPos.y = std::min(minPos.y, position.y);
+		minPos.z = std::min(minPos.z, position.z);
+
+		m_vertices.insert(position);
 	}
 
 	m_center = (maxPos + minPos) / 2.0f;
@@ -83,33 +63,17 @@ void BoxShape::setVertices(const std::vector<Vertex> &vertices)
 ConvexInfo BoxShape::getShapeInfo(const Transform &transform) const
 {
 	ConvexInfo box;
-	glm::mat4 matrix = transform.toMatrix();
+	box.shape = this;
+	box.position = transform.position;
+	box.orientation = glm::normalize(transform.orientation);
 
-	box.center = matrix * glm::vec4(m_center, 1.0f);
+	glm::mat3 rotation = glm::toMat3(box.orientation);
+	box.center = box.position + box.orientation * m_center;
 	box.halfSize = m_halfSize;
-
-	box.pointsCount = 8;
-	void *memory;
-	memory = PhysicsAllocator::m_blockAllocator.allocateBlock(sizeof(glm::vec3) * box.pointsCount);
-	box.points = static_cast<glm::vec3 *>(memory);
-
-	box.points[0] = matrix * glm::vec4(m_center - m_halfSize, 1.0f);
-	box.points[1] = matrix * glm::vec4(m_center + glm::vec3(m_halfSize.x, -m_halfSize.y, -m_halfSize.z), 1.0f);
-	box.points[2] = matrix * glm::vec4(m_center + glm::vec3(-m_halfSize.x, m_halfSize.y, -m_halfSize.z), 1.0f);
-	box.points[3] =	matrix * glm::vec4(m_center + glm::vec3(-m_halfSize.x, -m_halfSize.y, m_halfSize.z), 1.0f);
-	box.points[4] =	matrix * glm::vec4(m_center + glm::vec3(m_halfSize.x, m_halfSize.y, -m_halfSize.z), 1.0f);
-	box.points[5] =	matrix * glm::vec4(m_center + glm::vec3(m_halfSize.x, -m_halfSize.y, m_halfSize.z), 1.0f);
-	box.points[6] =	matrix * glm::vec4(m_center + glm::vec3(-m_halfSize.x, m_halfSize.y, m_halfSize.z), 1.0f);
-	box.points[7] =	matrix * glm::vec4(m_center + m_halfSize, 1.0f);
-
-	box.axesCount = 3;
-	memory = PhysicsAllocator::m_blockAllocator.allocateBlock(sizeof(glm::vec3) * box.axesCount);
-	box.axes = static_cast<glm::vec3 *>(memory);
-
-	box.axes[0] = glm::normalize(box.points[1] - box.points[0]);
-	box.axes[1] = glm::normalize(box.points[2] - box.points[0]);
-	box.axes[2] = glm::normalize(box.points[3] - box.points[0]);
-
+	box.axes[0] = rotation[0];
+	box.axes[1] = rotation[1];
+	box.axes[2] = rotation[2];
+	box.boundingRadius = glm::length(m_halfSize);
 
 	return box;
 }
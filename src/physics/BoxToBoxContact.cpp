@@ -3,6 +3,11 @@
 namespace ale
 {
 
+const float BoxToBoxContact::FACE_RELATIVE_TOLERANCE = 0.98f;
+const float BoxToBoxContact::FACE_ABSOLUTE_TOLERANCE = 0.001f;
+const float BoxToBoxContact::EDGE_RELATIVE_TOLERANCE = 0.95f;
+const float BoxToBoxContact::EDGE_ABSOLUTE_TOLERANCE = 0.01f;
+
 BoxToBoxContact::BoxToBoxContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB)
 	: Contact(fixtureA, fixtureB, indexA, indexB) {};
 
@@ -16,32 +21,313 @@ Contact *BoxToBoxContact::create(Fixture *fixtureA, Fixture *fixtureB, int32_t i
 	return new (static_cast<BoxToBoxContact *>(memory)) BoxToBoxContact(fixtureA, fixtureB, indexA, indexB);
 }
 
-glm::vec3 BoxToBoxContact::supportA(const ConvexInfo &box, glm::vec3 dir)
+void BoxToBoxContact::destroy(Contact *contact)
+{
+	static_cast<BoxToBoxContact *>(contact)->~BoxToBoxContact();
+	PhysicsAllocator::m_blockAllocator.freeBlock(contact, sizeof(BoxToBoxContact));
+}
+
+// 분리축 검사 (A의 면 3개, B의 면 3개, 모서리 쌍 9개)
+// 하나라도 겹치지 않으면 충돌 없음, 모두 겹치면 가장 얕게 겹치는 축으로 접촉점 생성
+void BoxToBoxContact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
 {
-	float dotAxes[3] = {glm::dot(box.axes[0], dir) > 0 ? 1.0f : -1.0f, glm::dot(box.axes[1], dir) > 0 ? 1.0f : -1.0f,
-						glm::dot(box.axes[2], dir) > 0 ? 1.0f : -1.0f};
+	ConvexInfo boxA = m_fixtureA->getShape()->getShapeInfo(transformA);
+	ConvexInfo boxB = m_fixtureB->getShape()->getShapeInfo(transformB);
+	glm::vec3 distance = boxB.center - boxA.center;
+
+	float overlapA = FLT_MAX;
+	int32_t axisA = 0;
+	for (int32_t i = 0; i < 3; ++i)
+	{
+		float overlap = getOverlap(boxA, boxB, boxA.axes[i], distance);
+		if (overlap < 0.0f)
+		{
+			return;
+		}
+
+		if (overlap < overlapA)
+		{
+			overlapA = overlap;
+			axisA = i;
+		}
+	}
+
+	float overlapB = FLT_MAX;
+	int32_t axisB = 0;
+	for (int32_t i = 0; i < 3; ++i)
+	{
+		float overlap = getOverlap(boxA, boxB, boxB.axes[i], distance);
+		if (overlap < 0.0f)
+		{
+			return;
+		}
+
+		if (overlap < overlapB)
+		{
+			overlapB = overlap;
+			axisB = i;
+		}
+	}
+
+	float overlapEdge = FLT_MAX;
+	int32_t edgeA = 0;
+	int32_t edgeB = 0;
+	glm::vec3 edgeNormal(0.0f);
+	for (int32_t i = 0; i < 3; ++i)
+	{
+		for (int32_t j = 0; j < 3; ++j)
+		{
+			// 평행한 모서리 쌍은 면 축 검사에 포함됨
+			glm::vec3 axis = glm::cross(boxA.axes[i], boxB.axes[j]);
+			float length2 = glm::length2(axis);
+			if (length2 < 1e-6f)
+			{
+				continue;
+			}
+
+			axis /= std::sqrt(length2);
+			float overlap = getOverlap(boxA, boxB, axis, distance);
+			if (overlap < 0.0f)
+			{
+				return;
+			}
+
+			if (overlap < overlapEdge)
+			{
+				overlapEdge = overlap;
+				edgeA = i;
+				edgeB = j;
+				edgeNormal = axis;
+			}
+		}
+	}
+
+	// 프레임마다 축이 바뀌며 떨리지 않도록 A의 면 > B의 면 > 모서리 순으로 우선
+	bool isFlipped = overlapB < FACE_RELATIVE_TOLERANCE * overlapA - FACE_ABSOLUTE_TOLERANCE;
+	float overlapFace = isFlipped ? overlapB : overlapA;
+
+	if (overlapEdge < EDGE_RELATIVE_TOLERANCE * overlapFace - EDGE_ABSOLUTE_TOLERANCE)
+	{
+		glm::vec3 normal = glm::dot(edgeNormal, distance) < 0.0f ? -edgeNormal : edgeNormal;
+		buildEdgeContact(manifold, boxA, boxB, edgeA, edgeB, normal, overlapEdge);
+	}
+	else if (isFlipped == false)
+	{
+		glm::vec3 normal = glm::dot(boxA.axes[axisA], distance) < 0.0f ? -boxA.axes[axisA] : boxA.axes[axisA];
+		buildFaceContact(manifold, boxA, boxB, axisA, normal, false);
+	}
+	else
+	{
+		glm::vec3 normal = glm::dot(boxB.axes[axisB], distance) > 0.0f ? -boxB.axes[axisB] : boxB.axes[axisB];
+		buildFaceContact(manifold, boxB, boxA, axisB, normal, true);
+	}
+}
 
-	glm::vec3 point = box.center;
+// axis 위로 투영한 두 box 구간이 겹치는 길이 (음수면 분리)
+float BoxToBoxContact::getOverlap(const ConvexInfo &boxA, const ConvexInfo &boxB, const glm::vec3 &axis,
+								  const glm::vec3 &distance)
+{
+	float radiusA = 0.0f;
+	float radiusB = 0.0f;
 	for (int32_t i = 0; i < 3; ++i)
 	{
-		point += box.axes[i] * (dotAxes[i] * box.halfSize[i]);
+		radiusA += boxA.halfSize[i] * std::abs(glm::dot(boxA.axes[i], axis));
+		radiusB += boxB.halfSize[i] * std::abs(glm::dot(boxB.axes[i], axis));
 	}
 
-	return point;
+	return radiusA + radiusB - std::abs(glm::dot(distance, axis));
 }
 
-glm::vec3 BoxToBoxContact::supportB(const ConvexInfo &box, glm::vec3 dir)
+/*
+	32bit id = 5bit(unused)			|
+			   1bit(B가 reference)		|
+			   3bit(incident face)		|
+			   5bit(shape type A)		|
+			   5bit(shape type B)		|
+			   3bit(reference face)		|
+			   5bit(feature of A)		|
+			   5bit(feature of B)
+*/
+void BoxToBoxContact::buildFaceContact(Manifold &manifold, const ConvexInfo &refBox, const ConvexInfo &incBox,
+									   int32_t refAxis, const glm::vec3 &refNormal, bool isFlipped)
 {
-	float dotAxes[3] = {glm::dot(box.axes[0], dir) > 0 ? 1.0f : -1.0f, glm::dot(box.axes[1], dir) > 0 ? 1.0f : -1.0f,
-						glm::dot(box.axes[2], dir) > 0 ? 1.0f : -1.0f};
+	float refSign = glm::dot(refBox.axes[refAxis], refNormal) < 0.0f ? -1.0f : 1.0f;
+	glm::vec3 refCenter = refBox.center + refNormal * refBox.halfSize[refAxis];
+	float refDistance = glm::dot(refNormal, refCenter);
+	uint32_t refFace = refAxis * 2 + (refSign < 0.0f ? 1 : 0);
 
-	glm::vec3 point = box.center;
+	// refNormal과 가장 반대 방향을 향하는 incident box의 면
+	int32_t incAxis = 0;
+	float maxDotRes = -1.0f;
 	for (int32_t i = 0; i < 3; ++i)
 	{
-		point += box.axes[i] * (dotAxes[i] * box.halfSize[i]);
+		float nowDotRes = std::abs(glm::dot(incBox.axes[i], refNormal));
+		if (nowDotRes > maxDotRes)
+		{
+			maxDotRes = nowDotRes;
+			incAxis = i;
+		}
+	}
+
+	float incSign = glm::dot(incBox.axes[incAxis], refNormal) > 0.0f ? -1.0f : 1.0f;
+	glm::vec3 incCenter = incBox.center + incBox.axes[incAxis] * (incSign * incBox.halfSize[incAxis]);
+	uint32_t incFace = incAxis * 2 + (incSign < 0.0f ? 1 : 0);
+
+	int32_t incAxis1 = (incAxis + 1) % 3;
+	int32_t incAxis2 = (incAxis + 2) % 3;
+	const float signs[4][2] = {{1.0f, 1.0f}, {-1.0f, 1.0f}, {-1.0f, -1.0f}, {1.0f, -1.0f}};
+
+	// 사각형을 평면 4개로 자르면 최대 8개의 꼭지점
+	ClipVertex input[8];
+	ClipVertex output[8];
+	for (int32_t i = 0; i < 4; ++i)
+	{
+		input[i].point = incCenter + incBox.axes[incAxis1] * (signs[i][0] * incBox.halfSize[incAxis1]) +
+						 incBox.axes[incAxis2] * (signs[i][1] * incBox.halfSize[incAxis2]);
+		input[i].refFeature = 0;
+		input[i].incFeature = ((incSign > 0.0f ? 1u : 0u) << incAxis) | ((signs[i][0] > 0.0f ? 1u : 0u) << incAxis1) |
+							  ((signs[i][1] > 0.0f ? 1u : 0u) << incAxis2);
+	}
+
+	// reference face의 옆면 4개로 incident face를 자름
+	int32_t count = 4;
+	for (int32_t i = 0; i < 4; ++i)
+	{
+		int32_t sideAxis = (refAxis + 1 + i / 2) % 3;
+		glm::vec3 planeNormal = refBox.axes[sideAxis] * (i % 2 == 0 ? 1.0f : -1.0f);
+		float planeDist = glm::dot(planeNormal, refBox.center) + refBox.halfSize[sideAxis];
+
+		count = clipVertices(output, input, count, planeNormal, planeDist, i);
+		if (count == 0)
+		{
+			return;
+		}
+		std::copy(output, output + count, input);
+	}
+
+	uint32_t typeId = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+					  (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+	uint32_t faceId = (static_cast<uint32_t>(isFlipped) << 26) | (incFace << 23) | (refFace << 10);
+
+	// reference face 아래로 들어간 점만 접촉점으로 사용
+	ManifoldPoint points[8];
+	int32_t pointsCount = 0;
+	for (int32_t i = 0; i < count; ++i)
+	{
+		const ClipVertex &vertex = input[i];
+		float depth = refDistance - glm::dot(refNormal, vertex.point);
+		if (depth < 0.0f)
+		{
+			continue;
+		}
+
+		ManifoldPoint &manifoldPoint = points[pointsCount];
+		manifoldPoint.seperation = depth;
+		if (isFlipped)
+		{
+			manifoldPoint.normal = -refNormal;
+			manifoldPoint.pointA = vertex.point;
+			manifoldPoint.pointB = vertex.point + refNormal * depth;
+			manifoldPoint.id = typeId | faceId | (vertex.incFeature << 5) | vertex.refFeature;
+		}
+		else
+		{
+			manifoldPoint.normal = refNormal;
+			manifoldPoint.pointA = vertex.point + refNormal * depth;
+			manifoldPoint.pointB = vertex.point;
+			manifoldPoint.id = typeId | faceId | (vertex.refFeature << 5) | vertex.incFeature;
+		}
+		++pointsCount;
+	}
+
+	pointsCount = reduceManifoldPoints(points, pointsCount, refNormal);
+	std::copy(points, points + pointsCount, manifold.points);
+	manifold.pointsCount = pointsCount;
+}
+
+// 두 모서리 직선의 최근접점을 모서리 범위로 제한해서 접촉점 1개 생성
+void BoxToBoxContact::buildEdgeContact(Manifold &manifold, const ConvexInfo &boxA, const ConvexInfo &boxB,
+									   int32_t axisA, int32_t axisB, const glm::vec3 &normal, float overlap)
+{
+	// normal 방향으로 가장 멀리 있는 A의 모서리, 반대 방향으로 가장 멀리 있는 B의 모서리
+	glm::vec3 pointA = boxA.center;
+	glm::vec3 pointB = boxB.center;
+	uint32_t edgeA = axisA * 4;
+	uint32_t edgeB = axisB * 4;
+	for (int32_t i = 1; i < 3; ++i)
+	{
+		int32_t nowAxisA = (axisA + i) % 3;
+		float signA = glm::dot(boxA.axes[nowAxisA], normal) < 0.0f ? -1.0f : 1.0f;
+		pointA += boxA.axes[nowAxisA] * (signA * boxA.halfSize[nowAxisA]);
+		edgeA |= (signA > 0.0f ? 1u : 0u) << (i - 1);
+
+		int32_t nowAxisB = (axisB + i) % 3;
+		float signB = glm::dot(boxB.axes[nowAxisB], normal) > 0.0f ? -1.0f : 1.0f;
+		pointB += boxB.axes[nowAxisB] * (signB * boxB.halfSize[nowAxisB]);
+		edgeB |= (signB > 0.0f ? 1u : 0u) << (i - 1);
+	}
+
+	const glm::vec3 &dirA = boxA.axes[axisA];
+	const glm::vec3 &dirB = boxB.axes[axisB];
+	glm::vec3 r = pointA - pointB;
+	float b = glm::dot(dirA, dirB);
+	float c = glm::dot(dirA, r);
+	float f = glm::dot(dirB, r);
+	float denominator = 1.0f - b * b;
+
+	float s = 0.0f;
+	if (denominator > 1e-6f)
+	{
+		s = (b * f - c) / denominator;
+	}
+	s = std::clamp(s, -boxA.halfSize[axisA], boxA.halfSize[axisA]);
+	float t = std::clamp(b * s + f, -boxB.halfSize[axisB], boxB.halfSize[axisB]);
+
+	uint32_t typeId = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+					  (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+
+	ManifoldPoint &manifoldPoint = manifold.points[0];
+	manifoldPoint.normal = normal;
+	manifoldPoint.seperation = overlap;
+	manifoldPoint.pointA = pointA + dirA * s;
+	manifoldPoint.pointB = pointB + dirB * t;
+	manifoldPoint.id = typeId | (7u << 10) | (edgeA << 5) | edgeB;
+	manifold.pointsCount = 1;
+}
+
+// Sutherland-Hodgman으로 평면 바깥쪽을 잘라냄
+// 새로 생긴 점은 자른 평면 번호, 나가는/들어오는 방향, 안쪽 점의 incident feature로 구분
+int32_t BoxToBoxContact::clipVertices(ClipVertex *output, const ClipVertex *input, int32_t inputCount,
+									  const glm::vec3 &planeNormal, float planeDist, int32_t planeIndex)
+{
+	int32_t outputCount = 0;
+	for (int32_t i = 0; i < inputCount; ++i)
+	{
+		const ClipVertex &vertex1 = input[i];
+		const ClipVertex &vertex2 = input[(i + 1) % inputCount];
+		float distance1 = glm::dot(planeNormal, vertex1.point) - planeDist;
+		float distance2 = glm::dot(planeNormal, vertex2.point) - planeDist;
+		bool isInside1 = distance1 <= 0.0f;
+		bool isInside2 = distance2 <= 0.0f;
+
+		if (isInside1)
+		{
+			output[outputCount] = vertex1;
+			++outputCount;
+		}
+
+		if (isInside1 != isInside2)
+		{
+			float t = distance1 / (distance1 - distance2);
+			ClipVertex &clipVertex = output[outputCount];
+			clipVertex.point = vertex1.point + (vertex2.point - vertex1.point) * t;
+			clipVertex.refFeature = static_cast<uint32_t>(planeIndex + 1) | (isInside1 ? 0u : 8u);
+			clipVertex.incFeature = isInside1 ? vertex1.incFeature : vertex2.incFeature;
+			++outputCount;
+		}
 	}
 
-	return point;
+	return outputCount;
 }
 
 void BoxToBoxContact::findCollisionPoints(const ConvexInfo &boxA, const ConvexInfo &boxB, CollisionInfo &collisionInfo,
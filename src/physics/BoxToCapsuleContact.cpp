@@ -1,4 +1,5 @@
 #include "physics/BoxToCapsuleContact.h"
+#include "physics/CapsuleShape.h"
 
 namespace ale
 {
@@ -16,36 +17,270 @@ Contact *BoxToCapsuleContact::create(Fixture *fixtureA, Fixture *fixtureB, int32
 	return new (static_cast<BoxToCapsuleContact *>(memory)) BoxToCapsuleContact(fixtureA, fixtureB, indexA, indexB);
 }
 
-glm::vec3 BoxToCapsuleContact::supportA(const ConvexInfo &box, glm::vec3 dir)
+void BoxToCapsuleContact::destroy(Contact *contact)
 {
-	float dotAxes[3] = {glm::dot(box.axes[0], dir) > 0 ? 1.0f : -1.0f, glm::dot(box.axes[1], dir) > 0 ? 1.0f : -1.0f,
-						glm::dot(box.axes[2], dir) > 0 ? 1.0f : -1.0f};
+	static_cast<BoxToCapsuleContact *>(contact)->~BoxToCapsuleContact();
+	PhysicsAllocator::m_blockAllocator.freeBlock(contact, sizeof(BoxToCapsuleContact));
+}
+
+// capsule 선분을 box의 local 좌표로 옮겨 box와 선분의 최근접점을 구함
+// 최근접점이 box 면 위에 있으면 선분을 그 면 범위로 잘라 양 끝에 접촉점 최대 2개 생성
+// 선분 자체가 box를 관통한 경우만 GJK/EPA로 처리
+void BoxToCapsuleContact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
+{
+	ConvexInfo box = m_fixtureA->getShape()->getShapeInfo(transformA);
+	ConvexInfo capsule = m_fixtureB->getShape()->getShapeInfo(transformB);
+
+	auto toWorld = [&box](const glm::vec3 &local) {
+		return box.axes[0] * local.x + box.axes[1] * local.y + box.axes[2] * local.z;
+	};
+
+	const glm::vec3 &halfSize = box.halfSize;
+	glm::vec3 distance = capsule.center - box.center;
+	glm::vec3 localCenter(glm::dot(distance, box.axes[0]), glm::dot(distance, box.axes[1]),
+						  glm::dot(distance, box.axes[2]));
+	glm::vec3 localAxis(glm::dot(capsule.axes[0], box.axes[0]), glm::dot(capsule.axes[0], box.axes[1]),
+						glm::dot(capsule.axes[0], box.axes[2]));
+	glm::vec3 start = localCenter - localAxis * (capsule.height * 0.5f);
+	glm::vec3 end = localCenter + localAxis * (capsule.height * 0.5f);
+
+	if (isSegmentInBox(start, end, halfSize))
+	{
+		evaluateConvex<BoxShape, CapsuleShape>(manifold, transformA, transformB);
+		return;
+	}
+
+	// 선분 양 끝점과 box, 선분과 box 모서리 12개 중 가장 가까운 쌍
+	glm::vec3 closestBox(0.0f);
+	glm::vec3 closestSegment(0.0f);
+	float minDistance2 = FLT_MAX;
+
+	const glm::vec3 endpoints[2] = {start, end};
+	for (int32_t i = 0; i < 2; ++i)
+	{
+		glm::vec3 clamped = glm::clamp(endpoints[i], -halfSize, halfSize);
+		float distance2 = glm::length2(endpoints[i] - clamped);
+		if (distance2 < minDistance2)
+		{
+			minDistance2 = distance2;
+			closestBox = clamped;
+			closestSegment = endpoints[i];
+		}
+	}
+
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		int32_t axis1 = (axis + 1) % 3;
+		int32_t axis2 = (axis + 2) % 3;
+		for (int32_t k = 0; k < 4; ++k)
+		{
+			glm::vec3 edgeStart;
+			edgeStart[axis] = -halfSize[axis];
+			edgeStart[axis1] = (k & 1) ? halfSize[axis1] : -halfSize[axis1];
+			edgeStart[axis2] = (k & 2) ? halfSize[axis2] : -halfSize[axis2];
+			glm::vec3 edgeEnd = edgeStart;
+			edgeEnd[axis] = halfSize[axis];
+
+			glm::vec3 closest1, closest2;
+			float distance2 = getClosestPoints(edgeStart, edgeEnd, start, end, closest1, closest2);
+			if (distance2 < minDistance2)
+			{
+				minDistance2 = distance2;
+				closestBox = closest1;
+				closestSegment = closest2;
+			}
+		}
+	}
+
+	float radius = capsule.radius;
+	if (minDistance2 >= radius * radius)
+	{
+		return;
+	}
+
+	float minDistance = std::sqrt(minDistance2);
+	if (minDistance < 1e-6f)
+	{
+		evaluateConvex<BoxShape, CapsuleShape>(manifold, transformA, transformB);
+		return;
+	}
+
+	uint32_t typeId = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+					  (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+
+	// box 위 최근접점의 축별 위치(-, 0, +)를 3진수로 압축, 경계에 걸린 축이 하나면 면
+	const float tolerance = 1e-4f;
+	uint32_t feature = 0;
+	int32_t faceAxis = -1;
+	int32_t boundaryCount = 0;
+	for (int32_t axis = 2; axis >= 0; --axis)
+	{
+		uint32_t digit = 1;
+		if (closestBox[axis] >= halfSize[axis] - tolerance)
+		{
+			digit = 2;
+		}
+		else if (closestBox[axis] <= -halfSize[axis] + tolerance)
+		{
+			digit = 0;
+		}
+
+		if (digit != 1)
+		{
+			faceAxis = axis;
+			++boundaryCount;
+		}
+		feature = feature * 3 + digit;
+	}
 
-	glm::vec3 point = box.center;
-	for (int32_t i = 0; i < 3; ++i)
+	int32_t pointsCount = 0;
+	if (boundaryCount == 1)
 	{
-		point += box.axes[i] * (dotAxes[i] * box.halfSize[i]);
+		float sign = closestBox[faceAxis] < 0.0f ? -1.0f : 1.0f;
+		glm::vec3 normal = box.axes[faceAxis] * sign;
+		uint32_t faceId = faceAxis * 2 + (sign < 0.0f ? 1 : 0);
+
+		// 선분을 면의 나머지 두 축 범위로 자름
+		glm::vec3 segment = end - start;
+		float params[2] = {0.0f, 1.0f};
+		for (int32_t i = 1; i < 3; ++i)
+		{
+			int32_t axis = (faceAxis + i) % 3;
+			if (std::abs(segment[axis]) < 1e-6f)
+			{
+				continue;
+			}
+
+			float t1 = (-halfSize[axis] - start[axis]) / segment[axis];
+			float t2 = (halfSize[axis] - start[axis]) / segment[axis];
+			params[0] = std::max(params[0], std::min(t1, t2));
+			params[1] = std::min(params[1], std::max(t1, t2));
+		}
+
+		int32_t paramsCount = params[1] - params[0] > 1e-4f ? 2 : 1;
+		for (int32_t i = 0; i < paramsCount; ++i)
+		{
+			glm::vec3 point = start + segment * params[i];
+			float pointDistance = sign * point[faceAxis] - halfSize[faceAxis];
+			float depth = radius - pointDistance;
+			if (depth <= 0.0f)
+			{
+				continue;
+			}
+
+			glm::vec3 worldPoint = box.center + toWorld(point);
+			ManifoldPoint &manifoldPoint = manifold.points[pointsCount];
+			manifoldPoint.normal = normal;
+			manifoldPoint.seperation = depth;
+			manifoldPoint.pointA = worldPoint - normal * pointDistance;
+			manifoldPoint.pointB = worldPoint - normal * radius;
+			manifoldPoint.id = typeId | (faceId << 10) | static_cast<uint32_t>(i);
+			++pointsCount;
+		}
+	}
+
+	// 모서리, 꼭지점에 닿은 경우 최근접점 1개
+	if (pointsCount == 0)
+	{
+		glm::vec3 normal = toWorld((closestSegment - closestBox) / minDistance);
+		ManifoldPoint &manifoldPoint = manifold.points[0];
+		manifoldPoint.normal = normal;
+		manifoldPoint.seperation = radius - minDistance;
+		manifoldPoint.pointA = box.center + toWorld(closestBox);
+		manifoldPoint.pointB = box.center + toWorld(closestSegment) - normal * radius;
+		manifoldPoint.id = typeId | (7u << 10) | (feature << 5);
+		pointsCount = 1;
 	}
 
-	return point;
+	manifold.pointsCount = pointsCount;
 }
 
-glm::vec3 BoxToCapsuleContact::supportB(const ConvexInfo &capsule, glm::vec3 dir)
+// box local 좌표에서 선분이 box와 교차하는지 (slab 검사)
+bool BoxToCapsuleContact::isSegmentInBox(const glm::vec3 &start, const glm::vec3 &end, const glm::vec3 &halfSize)
 {
-	float dotResult = glm::dot(dir, capsule.axes[0]);
+	glm::vec3 segment = end - start;
+	float tMin = 0.0f;
+	float tMax = 1.0f;
+
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		if (std::abs(segment[axis]) < 1e-6f)
+		{
+			if (std::abs(start[axis]) > halfSize[axis])
+			{
+				return false;
+			}
+			continue;
+		}
 
-	glm::vec3 move(0.0f);
+		float t1 = (-halfSize[axis] - start[axis]) / segment[axis];
+		float t2 = (halfSize[axis] - start[axis]) / segment[axis];
+		tMin = std::max(tMin, std::min(t1, t2));
+		tMax = std::min(tMax, std::max(t1, t2));
+		if (tMin > tMax)
+		{
+			return false;
+		}
+	}
 
-	if (dotResult > 0)
+	return true;
+}
+
+// 두 선분의 최근접점과 거리의 제곱
+float BoxToCapsuleContact::getClosestPoints(const glm::vec3 &start1, const glm::vec3 &end1, const glm::vec3 &start2,
+											const glm::vec3 &end2, glm::vec3 &closest1, glm::vec3 &closest2)
+{
+	glm::vec3 d1 = end1 - start1;
+	glm::vec3 d2 = end2 - start2;
+	glm::vec3 r = start1 - start2;
+	float a = glm::dot(d1, d1);
+	float e = glm::dot(d2, d2);
+	float f = glm::dot(d2, r);
+
+	float s = 0.0f;
+	float t = 0.0f;
+	if (a <= 1e-8f && e <= 1e-8f)
 	{
-		move = capsule.axes[0] * capsule.height * 0.5f;
+		s = 0.0f;
+		t = 0.0f;
 	}
-	else if (dotResult < 0)
+	else if (a <= 1e-8f)
 	{
-		move = -capsule.axes[0] * capsule.height * 0.5f;
+		t = std::clamp(f / e, 0.0f, 1.0f);
+	}
+	else
+	{
+		float c = glm::dot(d1, r);
+		if (e <= 1e-8f)
+		{
+			s = std::clamp(-c / a, 0.0f, 1.0f);
+		}
+		else
+		{
+			float b = glm::dot(d1, d2);
+			float denominator = a * e - b * b;
+			if (denominator > 1e-8f)
+			{
+				s = std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f);
+			}
+
+			t = (b * s + f) / e;
+			if (t < 0.0f)
+			{
+				t = 0.0f;
+				s = std::clamp(-c / a, 0.0f, 1.0f);
+			}
+			else if (t > 1.0f)
+			{
+				t = 1.0f;
+				s = std::clamp((b - c) / a, 0.0f, 1.0f);
+			}
+		}
 	}
 
-	return capsule.center + move + dir * capsule.radius;
+	closest1 = start1 + d1 * s;
+	closest2 = start2 + d2 * t;
+	return glm::length2(closest1 - closest2);
 }
 
 void BoxToCapsuleContact::findCollisionPoints(const ConvexInfo &box, const ConvexInfo &capsule,
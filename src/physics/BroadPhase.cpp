@@ -7,22 +7,64 @@ BroadPhase::BroadPhase()
 	m_moveCount = 0;
 	m_moveCapacity = 16;
 	m_moveBuffer.resize(m_moveCapacity);
+
+	m_pairCount = 0;
+	m_pairCapacity = 16;
+	m_pairBuffer.resize(m_pairCapacity);
+
+	m_useWideTree = false;
+	m_isRefitMode = false;
+	m_refitRebuildRatio = 0.0f;
+	m_refitBaseCost = 0.0f;
+	m_isStaticTreeDirty = false;
+	m_isQueryingStaticTree = false;
 }
 
-int32_t BroadPhase::createProxy(const AABB &aabb, void *userData)
+int32_t BroadPhase::createProxy(const AABB &aabb, void *userData, bool isStatic)
 {
-	int32_t proxyId = m_tree.createProxy(aabb, userData);
+	if (isStatic)
+	{
+		// static proxy는 move buffer에 넣지 않고 다음 updatePairs에서 dynamic tree와만 검사
+		int32_t proxyId = makeProxyId(m_staticTree.createProxy(aabb, userData), true);
+		m_newStaticProxies.push_back(proxyId);
+		m_isStaticTreeDirty = true;
+		return proxyId;
+	}
+
+	int32_t proxyId = makeProxyId(m_dynamicTree.createProxy(aabb, userData), false);
 	bufferMove(proxyId);
 	return proxyId;
 }
 
 void BroadPhase::destroyProxy(int32_t proxyId)
 {
+	if (isStaticProxy(proxyId))
+	{
+		m_newStaticProxies.erase(std::remove(m_newStaticProxies.begin(), m_newStaticProxies.end(), proxyId),
+								 m_newStaticProxies.end());
+		m_staticTree.destroyProxy(getNodeId(proxyId));
+		m_isStaticTreeDirty = true;
+		return;
+	}
+
+	unBufferMove(proxyId);
+	m_dynamicTree.destroyProxy(getNodeId(proxyId));
 }
 
 void BroadPhase::moveProxy(int32_t proxyId, const AABB &aabb, const glm::vec3 &displacement)
 {
-	bool buffer = m_tree.moveProxy(proxyId, aabb, displacement);
+	// static body는 synchronizeFixtures에서 건너뛰므로 여기로 오지 않음
+	assert(isStaticProxy(proxyId) == false);
+
+	bool buffer;
+	if (m_isRefitMode)
+	{
+		buffer = m_dynamicTree.enlargeProxy(getNodeId(proxyId), aabb, displacement);
+	}
+	else
+	{
+		buffer = m_dynamicTree.moveProxy(getNodeId(proxyId), aabb, displacement);
+	}
 	if (buffer)
 	{
 		bufferMove(proxyId);
@@ -40,28 +82,120 @@ void BroadPhase::bufferMove(int32_t proxyId)
 	++m_moveCount;
 }
 
-bool BroadPhase::queryCallback(int32_t proxyId)
+void BroadPhase::unBufferMove(int32_t proxyId)
 {
+	for (int32_t i = 0; i < m_moveCount; ++i)
+	{
+		if (m_moveBuffer[i] == proxyId)
+		{
+			m_moveBuffer[i] = NULL_PROXY;
+		}
+	}
+}
+
+void BroadPhase::setWideTreeQuery(bool enabled)
+{
+	m_useWideTree = enabled;
+}
+
+void BroadPhase::setRefitMode(bool enabled, float rebuildCostRatio)
+{
+	// 끌 때는 남은 leaf의 조상을 갱신해 두어야 moveProxy가 올바른 tree에서 insert
+	if (m_isRefitMode && enabled == false)
+	{
+		m_dynamicTree.refit();
+	}
+
+	m_isRefitMode = enabled;
+	m_refitRebuildRatio = rebuildCostRatio;
+	m_refitBaseCost = m_dynamicTree.getTotalCost();
+}
+
+bool BroadPhase::queryCallback(int32_t nodeId)
+{
+	int32_t proxyId = makeProxyId(nodeId, m_isQueryingStaticTree);
 	if (proxyId == m_queryProxyId)
 	{
 		return true;
 	}
 
-	m_proxySet.insert({std::min(proxyId, m_queryProxyId), std::max(proxyId, m_queryProxyId)});
-	// std::cout << "proxyset insert: " << proxyId << ", " << m_queryProxyId << '\n';
+	if (m_pairCount == m_pairCapacity)
+	{
+		m_pairCapacity *= 2;
+		m_pairBuffer.resize(m_pairCapacity);
+	}
+	m_pairBuffer[m_pairCount] = {std::min(proxyId, m_queryProxyId), std::max(proxyId, m_queryProxyId)};
+	++m_pairCount;
+	// std::cout << "pair buffer insert: " << proxyId << ", " << m_queryProxyId << '\n';
 	return true;
 }
 
-// const AABB &BroadPhase::getFatAABB(int32_t proxyId) const
-// {
-// }
+bool BroadPhase::testOverlap(int32_t proxyIdA, int32_t proxyIdB) const
+{
+	const AABB &aabbA = getFatAABB(proxyIdA);
+	const AABB &aabbB = getFatAABB(proxyIdB);
+	return ale::testOverlap(aabbA, aabbB);
+}
+
+const AABB &BroadPhase::getFatAABB(int32_t proxyId) const
+{
+	return getTree(proxyId).getFatAABB(getNodeId(proxyId));
+}
+
+void *BroadPhase::getUserData(int32_t proxyId) const
+{
+	return getTree(proxyId).getUserData(getNodeId(proxyId));
+}
+
+int32_t BroadPhase::makeProxyId(int32_t nodeId, bool isStatic)
+{
+	return (nodeId << 1) | (isStatic ? 1 : 0);
+}
+
+int32_t BroadPhase::getNodeId(int32_t proxyId)
+{
+	return proxyId >> 1;
+}
 
-// bool BroadPhase::TestOverlap(int32_t proxyIdA, int32_t proxyIdB) const
-// {
-// }
+bool BroadPhase::isStaticProxy(int32_t proxyId)
+{
+	return (proxyId & 1) != 0;
+}
 
-// void *BroadPhase::getUserData(int32_t proxyId) const
-// {
-// }
+const DynamicTree &BroadPhase::getTree(int32_t proxyId) const
+{
+	return isStaticProxy(proxyId) ? m_staticTree : m_dynamicTree;
+}
+
+void BroadPhase::refitDynamicTree()
+{
+	m_dynamicTree.refit();
+
+	// 빈 tree에서 켠 경우 처음 refit한 비용을 기준으로 삼음
+	float cost = m_dynamicTree.getTotalCost();
+	if (m_refitBaseCost <= 0.0f)
+	{
+		m_refitBaseCost = cost;
+		return;
+	}
+
+	if (cost > m_refitBaseCost * m_refitRebuildRatio)
+	{
+		m_dynamicTree.rebuild();
+		m_refitBaseCost = m_dynamicTree.getTotalCost();
+	}
+}
+
+void BroadPhase::updateStaticTree()
+{
+	if (m_isStaticTreeDirty == false)
+	{
+		return;
+	}
+
+	m_staticTree.rebuild();
+	m_staticWideTree.build(m_staticTree);
+	m_isStaticTreeDirty = false;
+}
 
-} // namespace ale
\ No newline at end of file
+} // namespace ale
@@ -3,6 +3,8 @@
 namespace ale
 {
 
+const float CapsuleToCapsuleContact::PARALLEL_TOLERANCE = 1e-4f;
+
 CapsuleToCapsuleContact::CapsuleToCapsuleContact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB)
 	: Contact(fixtureA, fixtureB, indexA, indexB) {};
 
@@ -17,47 +19,85 @@ Contact *CapsuleToCapsuleContact::create(Fixture *fixtureA, Fixture *fixtureB, i
 		CapsuleToCapsuleContact(fixtureA, fixtureB, indexA, indexB);
 }
 
-glm::vec3 CapsuleToCapsuleContact::supportA(const ConvexInfo &capsule, glm::vec3 dir)
+void CapsuleToCapsuleContact::destroy(Contact *contact)
 {
-	// std::cout << "supportA dir: " << dir.x << " " << dir.y << " " << dir.z << "\n";
-	float dotResult = glm::dot(dir, capsule.axes[0]);
-
-	glm::vec3 move(0.0f);
-
-	// std::cout << "dotResult: " << dotResult << "\n";
-	if (dotResult > 0)
-	{
-		move = capsule.axes[0] * capsule.height * 0.5f;
-	}
-	else if (dotResult < 0)
-	{
-		move = -capsule.axes[0] * capsule.height * 0.5f;
-	}
-
-	return capsule.center + move + dir * capsule.radius;
+	static_cast<CapsuleToCapsuleContact *>(contact)->~CapsuleToCapsuleContact();
+	PhysicsAllocator::m_blockAllocator.freeBlock(contact, sizeof(CapsuleToCapsuleContact));
 }
 
-glm::vec3 CapsuleToCapsuleContact::supportB(const ConvexInfo &capsule, glm::vec3 dir)
+// 두 선분의 최근접점을 구하고 두 구의 충돌로 처리
+// 거의 평행하면 겹치는 구간의 양 끝에 접촉점 2개를 만들어 굴러다니지 않도록 함
+void CapsuleToCapsuleContact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
 {
-	// std::cout << "supportB dir: " << dir.x << " " << dir.y << " " << dir.z << "\n";
+	ConvexInfo capsuleA = m_fixtureA->getShape()->getShapeInfo(transformA);
+	ConvexInfo capsuleB = m_fixtureB->getShape()->getShapeInfo(transformB);
+
+	float halfHeightA = capsuleA.height * 0.5f;
+	float halfHeightB = capsuleB.height * 0.5f;
+	const glm::vec3 &dirA = capsuleA.axes[0];
+	const glm::vec3 &dirB = capsuleB.axes[0];
+
+	glm::vec3 r = capsuleA.center - capsuleB.center;
+	float b = glm::dot(dirA, dirB);
+	float c = glm::dot(dirA, r);
+	float f = glm::dot(dirB, r);
+	float denominator = 1.0f - b * b;
 
-	float dotResult = glm::dot(dir, capsule.axes[0]);
+	// A 선분 위의 매개변수 (A 중심 기준)
+	float params[2];
+	int32_t paramsCount = 1;
 
-	glm::vec3 move(0.0f);
-	// std::cout << "dotResult: " << dotResult << "\n";
+	if (denominator < PARALLEL_TOLERANCE)
+	{
+		float centerB = -c;
+		float extentB = halfHeightB * std::abs(b);
+		float lower = std::max(-halfHeightA, centerB - extentB);
+		float upper = std::min(halfHeightA, centerB + extentB);
 
-	if (dotResult > 0)
+		if (lower < upper)
+		{
+			params[0] = lower;
+			params[1] = upper;
+			paramsCount = 2;
+		}
+		else
+		{
+			params[0] = std::clamp(centerB, -halfHeightA, halfHeightA);
+		}
+	}
+	else
 	{
-		move = capsule.axes[0] * capsule.height * 0.5f;
+		float s = std::clamp((b * f - c) / denominator, -halfHeightA, halfHeightA);
+		float t = b * s + f;
+		if (t < -halfHeightB || t > halfHeightB)
+		{
+			t = std::clamp(t, -halfHeightB, halfHeightB);
+			s = std::clamp(b * t - c, -halfHeightA, halfHeightA);
+		}
+		params[0] = s;
 	}
-	else if (dotResult < 0)
+
+	uint32_t typeId = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+					  (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+
+	int32_t pointsCount = 0;
+	for (int32_t i = 0; i < paramsCount; ++i)
 	{
-		move = -capsule.axes[0] * capsule.height * 0.5f;
+		glm::vec3 pointA = capsuleA.center + dirA * params[i];
+		float t = std::clamp(glm::dot(pointA - capsuleB.center, dirB), -halfHeightB, halfHeightB);
+		glm::vec3 pointB = capsuleB.center + dirB * t;
+
+		ManifoldPoint &manifoldPoint = manifold.points[pointsCount];
+		if (setSphereContact(manifoldPoint, pointA, capsuleA.radius, pointB, capsuleB.radius))
+		{
+			manifoldPoint.id = typeId | static_cast<uint32_t>(paramsCount + i);
+			++pointsCount;
+		}
 	}
 
-	return capsule.center + move + dir * capsule.radius;
+	manifold.pointsCount = pointsCount;
 }
- 
+
 void CapsuleToCapsuleContact::findCollisionPoints(const ConvexInfo &capsuleA, const ConvexInfo &capsuleB,
 												  CollisionInfo &collisionInfo, EpaInfo &epaInfo,
 												  SimplexArray &simplexArray)
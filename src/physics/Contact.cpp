@@ -1,4 +1,6 @@
 #include "physics/Contact.h"
+#include "physics/CapsuleShape.h"
+#include "physics/CylinderShape.h"
 #include "physics/ShapeCollisions.h"
 
 namespace ale
@@ -59,6 +61,78 @@ contactMemberFunction Contact::createContactFunctions[32] = {
 	nullptr,							// 11111
 };
 
+contactDestroyFunction Contact::destroyContactFunctions[32] = {
+	nullptr,							 // 0
+	&SphereToSphereContact::destroy,	 // 01
+	&BoxToBoxContact::destroy,			 // 10
+	&SphereToBoxContact::destroy,		 // 11
+	&BoxToBoxContact::destroy,			 // 100
+	&SphereToBoxContact::destroy,		 // 101
+	&BoxToBoxContact::destroy,			 // 110
+	nullptr,							 // 111
+	&CylinderToCylinderContact::destroy, // 1000
+	&SphereToCylinderContact::destroy,	 // 1001
+	&BoxToCylinderContact::destroy,		 // 1010
+	nullptr,							 // 1011
+	&BoxToCylinderContact::destroy,		 // 1100
+	nullptr,							 // 1101
+	nullptr,							 // 1110
+	nullptr,							 // 1111
+	&CapsuleToCapsuleContact::destroy,	 // 10000
+	&SphereToCapsuleContact::destroy,	 // 10001
+	&BoxToCapsuleContact::destroy,		 // 10010
+	nullptr,							 // 10011
+	&BoxToCapsuleContact::destroy,		 // 10100
+	nullptr,							 // 10101
+	nullptr,							 // 10110
+	nullptr,							 // 10111
+	&CylinderToCapsuleContact::destroy,	 // 11000
+	nullptr,							 // 11001
+	nullptr,							 // 11010
+	nullptr,							 // 11011
+	nullptr,							 // 11100
+	nullptr,							 // 11101
+	nullptr,							 // 11110
+	nullptr,							 // 11111
+};
+
+contactUpdateFunction Contact::updateContactFunctions[32] = {
+	nullptr,												 // 0
+	&SphereToSphereContact::updateContacts,				 // 01
+	&Contact::updateContacts<BoxToBoxContact>,				 // 10
+	&SphereToBoxContact::updateContacts,					 // 11
+	&Contact::updateContacts<BoxToBoxContact>,				 // 100
+	&SphereToBoxContact::updateContacts,					 // 101
+	&Contact::updateContacts<BoxToBoxContact>,				 // 110
+	nullptr,												 // 111
+	&Contact::updateContacts<CylinderToCylinderContact>,	 // 1000
+	&Contact::updateContacts<SphereToCylinderContact>,		 // 1001
+	&Contact::updateContacts<BoxToCylinderContact>,			 // 1010
+	nullptr,												 // 1011
+	&Contact::updateContacts<BoxToCylinderContact>,			 // 1100
+	nullptr,												 // 1101
+	nullptr,												 // 1110
+	nullptr,												 // 1111
+	&Contact::updateContacts<CapsuleToCapsuleContact>,		 // 10000
+	&Contact::updateContacts<SphereToCapsuleContact>,		 // 10001
+	&Contact::updateContacts<BoxToCapsuleContact>,			 // 10010
+	nullptr,												 // 10011
+	&Contact::updateContacts<BoxToCapsuleContact>,			 // 10100
+	nullptr,												 // 10101
+	nullptr,												 // 10110
+	nullptr,												 // 10111
+	&Contact::updateContacts<CylinderToCapsuleContact>,		 // 11000
+	nullptr,												 // 11001
+	nullptr,												 // 11010
+	nullptr,												 // 11011
+	nullptr,												 // 11100
+	nullptr,												 // 11101
+	nullptr,												 // 11110
+	nullptr,												 // 11111
+};
+
+thread_local EpaArena Contact::m_epaArena;
+
 Contact::Contact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t indexB)
 	: m_fixtureA(fixtureA), m_fixtureB(fixtureB), m_indexA(indexA), m_indexB(indexB)
 {
@@ -83,6 +157,10 @@ Contact::Contact(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, int32_t i
 	m_nodeB.next = nullptr;
 	m_nodeB.other = nullptr;
 
+	m_manifold.pointsCount = 0;
+	m_manifoldCache.isValid = false;
+	m_hasCachedAxis = false;
+
 	m_friction = std::sqrt(m_fixtureA->getFriction() * m_fixtureB->getFriction());
 	m_restitution = std::max(m_fixtureA->getRestitution(), m_fixtureB->getRestitution());
 }
@@ -106,7 +184,40 @@ Contact *Contact::create(Fixture *fixtureA, Fixture *fixtureB, int32_t indexA, i
 	return createContactFunctions[type1 | type2](fixtureA, fixtureB, indexA, indexB);
 }
 
+// create와 같은 type 조합으로 실제 contact 크기만큼 block 반환
+void Contact::destroy(Contact *contact)
+{
+	EType type1 = contact->getFixtureA()->getType();
+	EType type2 = contact->getFixtureB()->getType();
+
+	destroyContactFunctions[type1 | type2](contact);
+}
+
+void Contact::updateBatch(int32_t pairType, ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+						  const ManifoldReuseThreshold &reuseThreshold)
+{
+	updateContactFunctions[pairType](contactUpdates, order, count, reuseThreshold);
+}
+
+// 같은 type의 contact만 모아서 호출되므로 evaluate 대상이 고정되어 분기 예측과 icache가 유리
+template <typename T>
+void Contact::updateContacts(ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+							 const ManifoldReuseThreshold &reuseThreshold)
+{
+	for (int32_t i = 0; i < count; ++i)
+	{
+		ContactUpdate &contactUpdate = contactUpdates[order[i]];
+		contactUpdate.touching = contactUpdate.contact->updateManifold<T>(reuseThreshold);
+	}
+}
+
 void Contact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
+{
+	evaluateConvex<Shape, Shape>(manifold, transformA, transformB);
+}
+
+template <typename ShapeA, typename ShapeB>
+void Contact::evaluateConvex(Manifold &manifold, const Transform &transformA, const Transform &transformB)
 {
 	// std::cout << "\n\n\n\n\nevaluate start\n";
 	Shape *shapeA = m_fixtureA->getShape();
@@ -116,6 +227,12 @@ void Contact::evaluate(Manifold &manifold, const Transform &transformA, const Tr
 	ConvexInfo convexA = shapeA->getShapeInfo(transformA);
 	ConvexInfo convexB = shapeB->getShapeInfo(transformB);
 
+	// GJK 전에 bounding sphere, bounding box로 확실히 떨어진 쌍은 빈 manifold로 종료
+	if (checkSphereToSphereCollide(convexA, convexB) == false || checkBoxToBoxCollide(convexA, convexB) == false)
+	{
+		return;
+	}
+
 	SimplexArray simplexArray;
 	CollisionInfo collisionInfo;
 
@@ -123,35 +240,46 @@ void Contact::evaluate(Manifold &manifold, const Transform &transformA, const Tr
 	collisionInfo.size = 0;
 
 	// std::cout << "GJK start\n";
-	bool isCollide = getGjkResult(convexA, convexB, simplexArray);
+	bool isCollide = getGjkResult<ShapeA, ShapeB>(convexA, convexB, simplexArray);
 
 	if (isCollide)
 	{
 		// std::cout << "EPA start\n";
-		EpaInfo epaInfo = getEpaResult(convexA, convexB, simplexArray);
+		EpaInfo epaInfo = getEpaResult<ShapeA, ShapeB>(convexA, convexB, simplexArray);
 
 		if (epaInfo.distance == -1.0f)
 		{
-			freeConvexInfo(convexA, convexB);
 			return;
 		}
 
+		m_cachedAxis = glm::conjugate(convexA.orientation) * epaInfo.normal;
+		m_hasCachedAxis = true;
+
 		// std::cout << "CLIPPING start\n";
 		findCollisionPoints(convexA, convexB, collisionInfo, epaInfo, simplexArray);
 
 		// std::cout << "createManifold start\n";
 		generateManifolds(collisionInfo, manifold, m_fixtureA, m_fixtureB);
 	}
-
-	freeConvexInfo(convexA, convexB);
 	// std::cout << "evaluate end!!\n";
 }
 
-void Contact::update()
+void Contact::update(const ManifoldReuseThreshold &reuseThreshold)
 {
-	// 이전 프레임에서 두 객체가 충돌중이었는지 확인
-	bool touching = false;
+	if (updateManifold(reuseThreshold))
+	{
+		m_flags = m_flags | EContactFlag::TOUCHING;
+	}
+	else
+	{
+		m_flags = m_flags & ~EContactFlag::TOUCHING;
+	}
+}
 
+// manifold만 다시 계산하고 flag는 변경하지 않음
+// contact 자신의 manifold에만 쓰므로 서로 다른 contact는 동시에 호출 가능
+bool Contact::updateManifold(const ManifoldReuseThreshold &reuseThreshold)
+{
 	// bodyA, bodyB의 Transform 가져오기
 	Rigidbody *bodyA = m_fixtureA->getBody();
 	Rigidbody *bodyB = m_fixtureB->getBody();
@@ -166,33 +294,146 @@ void Contact::update()
 	// 2. 충돌에 따른 manifold 생성
 	// 3. manifold의 내부 값을 impulse를 제외하고 채워줌
 	// 4. 실제 충돌이 일어나지 않은 경우 manifold.pointCount = 0인 충돌 생성
+	// 이전 manifold를 만든 뒤 두 body가 거의 움직이지 않았으면 접촉점만 다시 투영
+	if (reuseManifold(reuseThreshold, transformA, transformB))
+	{
+		return true;
+	}
+
+	int32_t oldPointsCount = m_manifold.pointsCount;
+	ManifoldPoint oldPoints[MAX_MANIFOLD_COUNT];
+	std::copy(m_manifold.points, m_manifold.points + oldPointsCount, oldPoints);
+
 	m_manifold.pointsCount = 0;
 	// std::cout << "start evaluate!!\n";
 	evaluate(m_manifold, transformA, transformB);
 	// std::cout << "finish evaluate!!\n";
-	touching = m_manifold.pointsCount > 0;
+
+	return finishManifold(reuseThreshold, oldPoints, oldPointsCount, transformA, transformB);
+}
+
+// updateManifold()와 같지만 evaluate를 T로 고정해서 호출
+template <typename T> bool Contact::updateManifold(const ManifoldReuseThreshold &reuseThreshold)
+{
+	const Transform &transformA = m_fixtureA->getBody()->getTransform();
+	const Transform &transformB = m_fixtureB->getBody()->getTransform();
+
+	if (reuseManifold(reuseThreshold, transformA, transformB))
+	{
+		return true;
+	}
+
+	int32_t oldPointsCount = m_manifold.pointsCount;
+	ManifoldPoint oldPoints[MAX_MANIFOLD_COUNT];
+	std::copy(m_manifold.points, m_manifold.points + oldPointsCount, oldPoints);
+
+	m_manifold.pointsCount = 0;
+	static_cast<T *>(this)->T::evaluate(m_manifold, transformA, transformB);
+
+	return finishManifold(reuseThreshold, oldPoints, oldPointsCount, transformA, transformB);
+}
+
+bool Contact::finishManifold(const ManifoldReuseThreshold &reuseThreshold, const ManifoldPoint *oldPoints,
+							 int32_t oldPointsCount, const Transform &transformA, const Transform &transformB)
+{
+	bool touching = m_manifold.pointsCount > 0;
 
 	// manifold의 충격량 0으로 초기화 및 old manifold 중
-	// 같은 충돌이 있는경우 Impulse 재사용
+	// 같은 충돌이 있는경우 Impulse 재사용 (warm starting)
 	// id 는 충돌 도형의 type과 vertex 또는 line의 index 정보를 압축하여 결정
-
+	bool isMatched[MAX_MANIFOLD_COUNT] = {};
 
 	for (int32_t i = 0; i < m_manifold.pointsCount; ++i)
 	{
 		ManifoldPoint &manifoldPoint = m_manifold.points[i];
 
 		manifoldPoint.normalImpulse = 0.0f;
-		manifoldPoint.tangentImpulse = 0.0f;
+		manifoldPoint.tangentImpulse = glm::vec3(0.0f);
+
+		for (int32_t j = 0; j < oldPointsCount; ++j)
+		{
+			// 같은 id를 가진 이전 point는 한 번만 재사용
+			if (isMatched[j] == false && oldPoints[j].id == manifoldPoint.id)
+			{
+				manifoldPoint.normalImpulse = oldPoints[j].normalImpulse;
+				manifoldPoint.tangentImpulse = oldPoints[j].tangentImpulse;
+				isMatched[j] = true;
+				break;
+			}
+		}
 	}
 
-	if (touching)
+	saveManifoldCache(reuseThreshold, transformA, transformB);
+	return touching;
+}
+
+// cache된 상대 자세와 현재 상대 자세의 차이가 threshold 이하이면
+// 접촉점을 현재 transform으로 옮기고 seperation만 갱신
+bool Contact::reuseManifold(const ManifoldReuseThreshold &reuseThreshold, const Transform &transformA,
+							const Transform &transformB)
+{
+	if (m_manifoldCache.isValid == false || m_manifold.pointsCount == 0)
 	{
-		m_flags = m_flags | EContactFlag::TOUCHING;
+		return false;
 	}
-	else
+
+	glm::quat inverseA = glm::conjugate(transformA.orientation);
+	glm::vec3 relativePosition = inverseA * (transformB.position - transformA.position);
+	glm::quat relativeOrientation = inverseA * transformB.orientation;
+
+	if (glm::length2(relativePosition - m_manifoldCache.relativePosition) >
+		reuseThreshold.linear * reuseThreshold.linear)
 	{
-		m_flags = m_flags & ~EContactFlag::TOUCHING;
+		return false;
+	}
+
+	// 작은 회전에서 |xyz| = sin(angle / 2) ~ angle / 2
+	glm::quat deltaOrientation = glm::conjugate(m_manifoldCache.relativeOrientation) * relativeOrientation;
+	float halfAngle = reuseThreshold.angular * 0.5f;
+	if (glm::length2(glm::vec3(deltaOrientation.x, deltaOrientation.y, deltaOrientation.z)) > halfAngle * halfAngle)
+	{
+		return false;
+	}
+
+	ManifoldPoint points[MAX_MANIFOLD_COUNT];
+	for (int32_t i = 0; i < m_manifold.pointsCount; ++i)
+	{
+		ManifoldPoint &manifoldPoint = points[i];
+		manifoldPoint = m_manifold.points[i];
+		manifoldPoint.pointA = transformA.position + transformA.orientation * m_manifoldCache.localPointA[i];
+		manifoldPoint.pointB = transformB.position + transformB.orientation * m_manifoldCache.localPointB[i];
+		manifoldPoint.normal = transformA.orientation * m_manifoldCache.localNormal[i];
+		manifoldPoint.seperation = glm::dot(manifoldPoint.normal, manifoldPoint.pointA - manifoldPoint.pointB);
+
+		// 떨어지기 시작한 점이 있으면 새로 계산
+		if (manifoldPoint.seperation < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	std::copy(points, points + m_manifold.pointsCount, m_manifold.points);
+	return true;
+}
+
+void Contact::saveManifoldCache(const ManifoldReuseThreshold &reuseThreshold, const Transform &transformA,
+								const Transform &transformB)
+{
+	glm::quat inverseA = glm::conjugate(transformA.orientation);
+	glm::quat inverseB = glm::conjugate(transformB.orientation);
+
+	m_manifoldCache.relativePosition = inverseA * (transformB.position - transformA.position);
+	m_manifoldCache.relativeOrientation = inverseA * transformB.orientation;
+
+	for (int32_t i = 0; i < m_manifold.pointsCount; ++i)
+	{
+		const ManifoldPoint &manifoldPoint = m_manifold.points[i];
+		m_manifoldCache.localPointA[i] = inverseA * (manifoldPoint.pointA - transformA.position);
+		m_manifoldCache.localPointB[i] = inverseB * (manifoldPoint.pointB - transformB.position);
+		m_manifoldCache.localNormal[i] = inverseA * manifoldPoint.normal;
 	}
+
+	m_manifoldCache.isValid = reuseThreshold.linear > 0.0f && reuseThreshold.angular > 0.0f;
 }
 
 float Contact::getFriction() const
@@ -205,6 +446,11 @@ float Contact::getRestitution() const
 	return m_restitution;
 }
 
+Contact *Contact::getPrev()
+{
+	return m_prev;
+}
+
 Contact *Contact::getNext()
 {
 	return m_next;
@@ -230,6 +476,12 @@ int32_t Contact::getChildIndexB() const
 	return m_indexB;
 }
 
+// createContactFunctions에서 사용하는 type 조합 index
+int32_t Contact::getPairType() const
+{
+	return m_fixtureA->getType() | m_fixtureB->getType();
+}
+
 ContactLink *Contact::getNodeA()
 {
 	return &m_nodeA;
@@ -272,13 +524,14 @@ bool Contact::hasFlag(EContactFlag flag)
 
 // manifold functions
 
-Simplex Contact::getSupportPoint(const ConvexInfo &convexA, const ConvexInfo &convexB, glm::vec3 &dir)
+template <typename ShapeA, typename ShapeB>
+Simplex Contact::getSupportPoint(const ConvexInfo &convexA, const ConvexInfo &convexB, const glm::vec3 &dir)
 {
 	Simplex simplex;
 	// std::cout << "getSupportPoint start!!\n";
 	// std::cout << "dir: " << dir.x << " " << dir.y << " " << dir.z << "\n";
-	simplex.a = supportA(convexA, dir);
-	simplex.b = supportB(convexB, -dir);
+	simplex.a = support<ShapeA>(convexA, dir);
+	simplex.b = support<ShapeB>(convexB, -dir);
 	simplex.diff = simplex.a - simplex.b;
 
 	// std::cout << "simplex.a : " << simplex.a.x << " " << simplex.a.y << " " << simplex.a.z << "\n";
@@ -288,6 +541,15 @@ Simplex Contact::getSupportPoint(const ConvexInfo &convexA, const ConvexInfo &co
 	return simplex;
 }
 
+// world 방향을 local로 돌려서 shape의 support point를 구한 뒤 다시 world로 변환
+// ShapeT의 getSupportPoint가 final이므로 ShapeT이 Shape이 아니면 virtual 호출 없이 inline 됨
+template <typename ShapeT> glm::vec3 Contact::support(const ConvexInfo &convex, const glm::vec3 &dir)
+{
+	glm::vec3 localDir = glm::conjugate(convex.orientation) * dir;
+	const ShapeT *shape = static_cast<const ShapeT *>(convex.shape);
+	return convex.position + convex.orientation * shape->getSupportPoint(localDir);
+}
+
 bool Contact::handleLineSimplex(SimplexArray &simplexArray, glm::vec3 &dir)
 {
 	// std::cout << "Line GJK\n";
@@ -477,18 +739,43 @@ bool Contact::isDuplicatedPoint(const SimplexArray &simplexArray, const glm::vec
 	return false;
 }
 
+// 두 bounding sphere가 겹치는지
 bool Contact::checkSphereToSphereCollide(const ConvexInfo &convexA, const ConvexInfo &convexB)
 {
-	if (glm::length(convexA.center - convexB.center) < (convexA.radius + convexB.radius))
-	{
-		return true;
-	}
-	else
+	float radius = convexA.boundingRadius + convexB.boundingRadius;
+	return glm::length2(convexA.center - convexB.center) < radius * radius;
+}
+
+// 두 bounding box(OBB)가 각자의 면 축 6개 위에서 모두 겹치는지
+// 모서리 축은 검사하지 않으므로 겹친다고 판단해도 실제로는 떨어져 있을 수 있음
+bool Contact::checkBoxToBoxCollide(const ConvexInfo &convexA, const ConvexInfo &convexB)
+{
+	glm::vec3 distance = convexB.center - convexA.center;
+	const ConvexInfo *boxes[2] = {&convexA, &convexB};
+
+	for (int32_t i = 0; i < 2; ++i)
 	{
-		return false;
+		for (int32_t j = 0; j < 3; ++j)
+		{
+			const glm::vec3 &axis = boxes[i]->axes[j];
+			float radius = 0.0f;
+			for (int32_t k = 0; k < 3; ++k)
+			{
+				radius += convexA.halfSize[k] * std::abs(glm::dot(convexA.axes[k], axis));
+				radius += convexB.halfSize[k] * std::abs(glm::dot(convexB.axes[k], axis));
+			}
+
+			if (std::abs(glm::dot(distance, axis)) > radius)
+			{
+				return false;
+			}
+		}
 	}
+
+	return true;
 }
 
+template <typename ShapeA, typename ShapeB>
 bool Contact::getGjkResult(const ConvexInfo &convexA, const ConvexInfo &convexB, SimplexArray &simplexArray)
 {
 	const int32_t ITERATION = 64;
@@ -496,7 +783,12 @@ bool Contact::getGjkResult(const ConvexInfo &convexA, const ConvexInfo &convexB,
 	glm::vec3 dir;
 
 	// 첫 번째 support point 구하기
-	if (glm::length2(convexB.center - convexA.center) < 1e-8f)
+	// 이전 프레임의 분리축(또는 충돌 normal)이 있으면 그 방향으로 시작
+	if (m_hasCachedAxis)
+	{
+		dir = convexA.orientation * m_cachedAxis;
+	}
+	else if (glm::length2(convexB.center - convexA.center) < 1e-8f)
 	{
 		dir = glm::vec3(1.0f, 0.0f, 0.0f);
 	}
@@ -505,16 +797,22 @@ bool Contact::getGjkResult(const ConvexInfo &convexA, const ConvexInfo &convexB,
 		dir = glm::normalize(convexB.center - convexA.center);
 	}
 
-	simplexArray.simplices[0] = getSupportPoint(convexA, convexB, dir);
+	simplexArray.simplices[0] = getSupportPoint<ShapeA, ShapeB>(convexA, convexB, dir);
 	++simplexArray.simplexCount;
 
 	glm::vec3 supportPoint = simplexArray.simplices[0].diff;
 
+	// 이전 분리축으로 여전히 분리되면 support 한 번으로 종료
+	if (m_hasCachedAxis && glm::dot(supportPoint, dir) < 0.0f)
+	{
+		return false;
+	}
+
 	// 두 번째 support point 구하기
 	if (glm::length2(supportPoint) == 0.0f)
 	{
 		dir = -dir;
-		simplexArray.simplices[0] = getSupportPoint(convexA, convexB, dir);
+		simplexArray.simplices[0] = getSupportPoint<ShapeA, ShapeB>(convexA, convexB, dir);
 		supportPoint = simplexArray.simplices[0].diff;
 	}
 
@@ -524,13 +822,19 @@ bool Contact::getGjkResult(const ConvexInfo &convexA, const ConvexInfo &convexB,
 	while (iter < ITERATION)
 	{
 		// 새로운 서포트 점
-		Simplex simplex = getSupportPoint(convexA, convexB, dir);
+		Simplex simplex = getSupportPoint<ShapeA, ShapeB>(convexA, convexB, dir);
 		supportPoint = simplex.diff;
 
 		// 만약 newSupport가 direction과 내적(dot)했을 때 0 이하라면
 		// 더 이상 원점을 "방향 dir" 쪽에서 감쌀 수 없음 => 충돌X
 		if (glm::dot(supportPoint, dir) < 0 || isDuplicatedPoint(simplexArray, supportPoint))
 		{
+			// 다음 프레임 시작 방향으로 A local 좌표에 저장
+			if (glm::length2(dir) > 1e-12f)
+			{
+				m_cachedAxis = glm::conjugate(convexA.orientation) * glm::normalize(dir);
+				m_hasCachedAxis = true;
+			}
 			return false; // 교차하지 않음
 		}
 
@@ -560,363 +864,530 @@ bool Contact::isSameDirection(glm::vec3 v1, glm::vec3 v2)
 	return glm::length2(glm::cross(v1, v2)) == 0.0f;
 }
 
+// GJK simplex(사면체)를 Minkowski 차의 경계까지 확장하여 원점에서 가장 가까운 면을 찾음
+// 면은 스레드별 arena의 min-heap에 두므로 가장 가까운 면을 heap top에서 바로 꺼냄
+template <typename ShapeA, typename ShapeB>
 EpaInfo Contact::getEpaResult(const ConvexInfo &convexA, const ConvexInfo &convexB, SimplexArray &simplexArray)
 {
-	FaceArray faceArray;
-	FaceArray newFaceArray;
-	int32_t initIdx[12] = {0, 1, 2, 0, 3, 1, 0, 2, 3, 1, 3, 2};
+	EpaArena &arena = m_epaArena;
+	arena.faceCount = 0;
+	arena.heapCount = 0;
+	arena.freeCount = 0;
+	arena.edgeCount = 0;
 
-	memcpy(faceArray.faces, initIdx, sizeof(int32_t) * 12);
-	faceArray.count = 4;
-
-	// std::cout << "simplex!!\n";
-	// for (int i = 0; i < simplexArray.simplexCount; ++i)
-	// {
-	// 	std::cout << "simplex[" << i << "]: (" << simplexArray.simplices[i].diff.x << ", "
-	// 			  << simplexArray.simplices[i].diff.y << ", " << simplexArray.simplices[i].diff.z << ")\n";
-	// }
-
-	// std::cout << "faceAttray.count: " << faceArray.count << "\n";
-	// GJK에서 구한 simplex들중 원점에서 가장 가까운 삼각형의 법선과 최소 거리
-	int32_t minFace = getFaceNormals(simplexArray, faceArray);
-	glm::vec3 minNormal(0.0f);
-	float minDistance = FLT_MAX;
+	EpaInfo epaInfo;
+	epaInfo.normal = glm::vec3(0.0f);
+	epaInfo.distance = -1.0f;
 
-	if (minFace == -1)
+	// 면 법선의 방향을 정할 다면체 내부 점
+	glm::vec3 sum(0.0f);
+	for (int32_t i = 0; i < simplexArray.simplexCount; ++i)
 	{
-		minDistance = -1.0f;
+		sum += simplexArray.simplices[i].diff;
 	}
-	// std::cout << "faceAttray.count: " << faceArray.count << "\n";
+	glm::vec3 center = sum / static_cast<float>(simplexArray.simplexCount);
 
-	// int b = 1;
-	while (minDistance == FLT_MAX)
+	const int32_t initIdx[12] = {0, 1, 2, 0, 3, 1, 0, 2, 3, 1, 3, 2};
+	for (int32_t i = 0; i < 12; i = i + 3)
 	{
-		// 	std::cout << "b: " << b << "\n";
-		// 	b++;
-		// std::cout << "simplex!!\n";
-		// for (Simplex &simplex : simplexVector)
-		// {
-		// 	std::cout << "(" << simplex.diff.x << ", " << simplex.diff.y << ", " << simplex.diff.z << ")\n";
-		// }
-
-		// std::cout << "loop start\n";
-		// std::cout << "faceAttray.count: " << faceArray.count << "\n";
-
-		// 최소 거리의 법선, 거리 쿼리
-		minNormal = glm::vec3(faceArray.normals[minFace]);
-		minDistance = faceArray.normals[minFace].w;
+		if (addEpaFace(arena, simplexArray, center, initIdx[i], initIdx[i + 1], initIdx[i + 2]) == false)
+		{
+			return epaInfo;
+		}
+	}
 
-		// std::cout << "minNormal: " << minNormal.x << " " << minNormal.y << " " << minNormal.z << "\n";
-		// std::cout << "minDistance: " << minDistance << "\n";
+	while (true)
+	{
+		// 원점에서 가장 가까운 면
+		const EpaFace &minFace = arena.faces[arena.heap[0]];
+		glm::vec3 minNormal = minFace.normal;
+		float minDistance = minFace.distance;
 
 		// 최소 거리의 법선에 해당하는 supportPoint 쿼리
-
-		Simplex simplex = getSupportPoint(convexA, convexB, minNormal);
+		Simplex simplex = getSupportPoint<ShapeA, ShapeB>(convexA, convexB, minNormal);
 		glm::vec3 supportPoint = simplex.diff;
-
-		// 원점에서 supportPoint까지의 거리
 		float supportDistance = glm::dot(minNormal, supportPoint);
 
-		// supportPoint가 현재 minDistance보다 원점에서 더 멀리있는 경우
-		// 다시 원점에서부터 최소거리의 삼각형을 찾음
-		// std::cout << "supportDistance: " << supportDistance << "\n";
-		// std::cout << "minDistance: " << minDistance << "\n";
-		// std::cout << "faceAttray.count: " << faceArray.count << "\n";
-
-		if (std::abs(supportDistance - minDistance) > 1e-2f && !isDuplicatedPoint(simplexArray, supportPoint) &&
-			simplexArray.simplexCount < MAX_SIMPLEX_COUNT)
+		// 더 이상 다면체가 확장되지 않으면 현재 면이 결과
+		if (std::abs(supportDistance - minDistance) <= 1e-2f || isDuplicatedPoint(simplexArray, supportPoint) ||
+			simplexArray.simplexCount >= MAX_SIMPLEX_COUNT)
 		{
-			// std::cout << "faceAttray.count: " << faceArray.count << "\n";
-			minDistance = FLT_MAX;
-
-			UniqueEdges uniqueEdges;
-			void *memory = PhysicsAllocator::m_stackAllocator.allocateStack(sizeof(std::pair<int32_t, int32_t>) *
-																			faceArray.count * 3);
-			uniqueEdges.edges = static_cast<std::pair<int32_t, int32_t> *>(memory);
-			uniqueEdges.size = 0;
+			epaInfo.normal = minNormal;
+			epaInfo.distance = minDistance;
+			return epaInfo;
+		}
 
-			for (int32_t i = 0; i < faceArray.count; i++)
-			{
-				// std::cout << "start addUniqueEdge()\n";
-				glm::vec3 center = (simplexArray.simplices[faceArray.faces[i * 3]].diff +
-									simplexArray.simplices[faceArray.faces[i * 3 + 1]].diff +
-									simplexArray.simplices[faceArray.faces[i * 3 + 2]].diff) /
+		// supportPoint에서 보이는 면 수집 (heap에는 살아있는 면만 있음)
+		int32_t visibleCount = 0;
+		for (int32_t i = 0; i < arena.heapCount; ++i)
+		{
+			const EpaFace &face = arena.faces[arena.heap[i]];
+			glm::vec3 faceCenter = (simplexArray.simplices[face.indices[0]].diff +
+									simplexArray.simplices[face.indices[1]].diff +
+									simplexArray.simplices[face.indices[2]].diff) /
 								   3.0f;
-				// std::cout << "faceAttray.count: " << faceArray.count << "\n";
-				// std::cout << "center: " << center.x << " " << center.y << " " << center.z << "\n";
-				// std::cout << "supportPoint: (" << supportPoint.x << ", " << supportPoint.y << ", " << supportPoint.z
-				// << ")\n"; std::cout << "supportPoint - center: " << supportPoint.x - center.x << " " <<
-				// supportPoint.y - center.y << " " << supportPoint.z - center.z << "\n"; std::cout << "normals[" << i
-				// << "]: " << normals[i].x << " " << normals[i].y << " " << normals[i].z << "\n";
-				if (isSimilarDirection(faceArray.normals[i], supportPoint - center))
-				{
-					int32_t faceIdx = i * 3;
-					// std::cout << "face " << i << " is in!!!!!!!!\n";
-					// std::cout << "faces: " << faces[faceIdx] << " " << faces[faceIdx + 1] << " " << faces[faceIdx +
-					// 2] << "\n";
-
-					// 해당 법선의 기존 삼각형의 edge들을 uniqueEdges에 저장
-					// 만약 같은 edge가 2번 들어오면 사라질 edge로 판단하여 삭제
-					// 1번만 들어오는 edge들만 모아서 새로운 점과 조합하여 새로운 삼각형 생성성
-					addIfUniqueEdge(uniqueEdges, faceArray.faces, faceIdx, faceIdx + 1);
-					addIfUniqueEdge(uniqueEdges, faceArray.faces, faceIdx + 1, faceIdx + 2);
-					addIfUniqueEdge(uniqueEdges, faceArray.faces, faceIdx + 2, faceIdx);
-
-					int32_t normalLastIdx = faceArray.count - 1;
-					int32_t faceLastIdx = (normalLastIdx) * 3;
-					// std::cout << "normalLastIdx: " << normalLastIdx << "\n";
-					// std::cout << "faceLastIdx: " << faceLastIdx << "\n";
-					faceArray.faces[faceIdx] = faceArray.faces[faceLastIdx];
-					faceArray.faces[faceIdx + 1] = faceArray.faces[faceLastIdx + 1];
-					faceArray.faces[faceIdx + 2] = faceArray.faces[faceLastIdx + 2];
-					faceArray.normals[i] = faceArray.normals[normalLastIdx]; // pop-erase
-
-					--faceArray.count;
-
-					--i;
-				}
+			if (isSimilarDirection(face.normal, supportPoint - faceCenter))
+			{
+				arena.visibleFaces[visibleCount] = arena.heap[i];
+				++visibleCount;
 			}
+		}
 
-			// uniqueEdge에 있는 edge들과 새로운 점을 조함하여 face 생성
+		// 보이는 면들의 edge 중 한 번만 나오는 edge가 지평선
+		arena.edgeCount = 0;
+		for (int32_t i = 0; i < visibleCount; ++i)
+		{
+			int32_t faceIdx = arena.visibleFaces[i];
+			const int32_t *indices = arena.faces[faceIdx].indices;
+			addHorizonEdge(arena, indices[0], indices[1]);
+			addHorizonEdge(arena, indices[1], indices[2]);
+			addHorizonEdge(arena, indices[2], indices[0]);
+			removeEpaFace(arena, faceIdx);
+		}
 
-			newFaceArray.count = 0;
+		// 새로 추가되는 면이 없다면 종료
+		if (arena.edgeCount == 0)
+		{
+			throw std::runtime_error("failed to EPA!");
+		}
+
+		// 새로운 점 추가
+		int32_t newIdx = simplexArray.simplexCount;
+		simplexArray.simplices[newIdx] = simplex;
+		++simplexArray.simplexCount;
+
+		sum += supportPoint;
+		center = sum / static_cast<float>(simplexArray.simplexCount);
 
-			int32_t uniqueEdgesCount = uniqueEdges.size;
-			for (int32_t i = 0; i < uniqueEdgesCount; ++i)
+		// 지평선 edge와 새로운 점으로 삼각형 생성
+		for (int32_t i = 0; i < arena.edgeCount; ++i)
+		{
+			if (addEpaFace(arena, simplexArray, center, arena.edges[i].first, arena.edges[i].second, newIdx) ==
+				false)
 			{
-				int32_t edgeIdx1 = uniqueEdges.edges[i].first;
-				int32_t edgeIdx2 = uniqueEdges.edges[i].second;
-				// std::cout << "add uniqueEdgeIdx1: " << edgeIndex1 << "\n";
-				// std::cout << "add uniqueEdgeIdx2: " << edgeIndex2 << "\n";
-				addFaceInFaceArray(newFaceArray, edgeIdx1, edgeIdx2, simplexArray.simplexCount);
+				return epaInfo;
 			}
+		}
+	}
+}
 
-			// 새로 추가되는 면이 없다면 종료료
-			if (newFaceArray.count == 0)
-			{
-				// std::cout << "simplex!!\n";
-				// for (Simplex &simplex : simplexVector)
-				// {
-				// 	std::cout << "(" << simplex.diff.x << ", " << simplex.diff.y << ", " << simplex.diff.z << ")\n";
-				// }
+// 삼각형의 법선, 원점까지 거리를 구해 heap에 추가
+// 원점이 면 바깥쪽에 있거나 면이 퇴화되었으면 false
+bool Contact::addEpaFace(EpaArena &arena, const SimplexArray &simplexArray, const glm::vec3 &center, int32_t idx1,
+						 int32_t idx2, int32_t idx3)
+{
+	const glm::vec3 &a = simplexArray.simplices[idx1].diff;
+	const glm::vec3 &b = simplexArray.simplices[idx2].diff;
+	const glm::vec3 &c = simplexArray.simplices[idx3].diff;
 
-				// std::cout << "normals size: " << normals.size() << "\n";
-				// std::cout << "minNormal: " << minNormal.x << " " << minNormal.y << " " << minNormal.z << "\n";
+	glm::vec3 crossResult = glm::cross(b - a, c - a);
+	if (glm::length2(crossResult) == 0.0f)
+	{
+		return false;
+	}
 
-				throw std::runtime_error("failed to EPA!");
-			}
+	glm::vec3 normal = glm::normalize(crossResult);
+	if (glm::dot(normal, a - center) < 0.0f)
+	{
+		normal = -normal;
+	}
 
-			PhysicsAllocator::m_stackAllocator.freeStack();
+	float distance = glm::dot(normal, a);
+	if (distance < 0.0f)
+	{
+		return false;
+	}
 
-			// std::cout << "add simplex!!\n";
+	// 지워진 slot이 있으면 재사용
+	int32_t faceIdx;
+	if (arena.freeCount > 0)
+	{
+		--arena.freeCount;
+		faceIdx = arena.freeFaces[arena.freeCount];
+	}
+	else
+	{
+		if (arena.faceCount >= MAX_EPA_FACE_COUNT)
+		{
+			throw std::runtime_error("failed to EPA!");
+		}
+		faceIdx = arena.faceCount;
+		++arena.faceCount;
+	}
 
-			// 새로운 점 추가
-			simplexArray.simplices[simplexArray.simplexCount] = simplex;
-			++simplexArray.simplexCount;
+	EpaFace &face = arena.faces[faceIdx];
+	face.normal = normal;
+	face.distance = distance;
+	face.indices[0] = idx1;
+	face.indices[1] = idx2;
+	face.indices[2] = idx3;
+	face.heapIndex = arena.heapCount;
 
-			// 새로운 삼각형의 normal 벡터들과 최소 거리 쿼리
-			int32_t newMinFace = getFaceNormals(simplexArray, newFaceArray);
-			float oldMinDistance = FLT_MAX;
+	arena.heap[arena.heapCount] = faceIdx;
+	++arena.heapCount;
+	siftUpEpaHeap(arena, face.heapIndex);
 
-			if (newMinFace == -1)
-			{
-				minNormal = glm::vec3(0.0f);
-				minDistance = -1.0f;
-				break;
-			}
+	return true;
+}
 
-			// std::cout << "find min dist\n";
-			// 기존 삼각형들 중 가장 거리가 짧은 삼각형 쿼리
-			int32_t normalsSize = faceArray.count;
-			for (int32_t i = 0; i < normalsSize; i++)
-			{
-				if (faceArray.normals[i].w < oldMinDistance)
-				{
-					oldMinDistance = faceArray.normals[i].w;
-					minFace = i;
-				}
-			}
+// heap에서 면을 빼고 slot을 반환
+void Contact::removeEpaFace(EpaArena &arena, int32_t faceIdx)
+{
+	int32_t heapIdx = arena.faces[faceIdx].heapIndex;
 
-			// std::cout << "find new min dist\n";
+	--arena.heapCount;
+	if (heapIdx != arena.heapCount)
+	{
+		int32_t lastFace = arena.heap[arena.heapCount];
+		arena.heap[heapIdx] = lastFace;
+		arena.faces[lastFace].heapIndex = heapIdx;
+		siftDownEpaHeap(arena, heapIdx);
+		siftUpEpaHeap(arena, arena.faces[lastFace].heapIndex);
+	}
 
-			// 새로운 삼각형들중 가장 짧은 거리가 존재하면 해당 face를 minFace로 설정
-			if (newFaceArray.normals[newMinFace].w < oldMinDistance)
-			{
-				minFace = newMinFace + faceArray.count;
-			}
+	arena.freeFaces[arena.freeCount] = faceIdx;
+	++arena.freeCount;
+}
+
+void Contact::siftUpEpaHeap(EpaArena &arena, int32_t heapIdx)
+{
+	int32_t faceIdx = arena.heap[heapIdx];
+	float distance = arena.faces[faceIdx].distance;
 
-			// std::cout << "merge!!\n";
-			// 새로운 face, normal 추가
-			mergeFaceArray(faceArray, newFaceArray);
-			// for (int z = 0; z < faces.size(); z = z + 3)
-			// {
-			// 	std::cout << "face: " << faces[z] << " " << faces[z + 1] << " " << faces[z + 2] << "\n";
-			// }
+	while (heapIdx > 0)
+	{
+		int32_t parent = (heapIdx - 1) / 2;
+		int32_t parentFace = arena.heap[parent];
+		if (arena.faces[parentFace].distance <= distance)
+		{
+			break;
 		}
-		// std::cout << "simplex!!\n";
-		// for (int i = 0; i < simplexArray.simplexCount; ++i)
-		// {
-		// 	std::cout << "simplex[" << i << "]: (" << simplexArray.simplices[i].diff.x << ", "
-		// 			  << simplexArray.simplices[i].diff.y << ", " << simplexArray.simplices[i].diff.z << ")\n";
-		// }
+
+		arena.heap[heapIdx] = parentFace;
+		arena.faces[parentFace].heapIndex = heapIdx;
+		heapIdx = parent;
 	}
 
-	PhysicsAllocator::m_blockAllocator.freeBlock(faceArray.faces, sizeof(int32_t) * faceArray.maxCount * 3);
-	PhysicsAllocator::m_blockAllocator.freeBlock(faceArray.normals, sizeof(glm::vec4) * faceArray.maxCount);
-	PhysicsAllocator::m_blockAllocator.freeBlock(newFaceArray.faces, sizeof(int32_t) * newFaceArray.maxCount * 3);
-	PhysicsAllocator::m_blockAllocator.freeBlock(newFaceArray.normals, sizeof(glm::vec4) * newFaceArray.maxCount);
+	arena.heap[heapIdx] = faceIdx;
+	arena.faces[faceIdx].heapIndex = heapIdx;
+}
 
-	EpaInfo epaInfo;
-	epaInfo.normal = minNormal;
-	epaInfo.distance = minDistance;
+void Contact::siftDownEpaHeap(EpaArena &arena, int32_t heapIdx)
+{
+	int32_t faceIdx = arena.heap[heapIdx];
+	float distance = arena.faces[faceIdx].distance;
+
+	while (true)
+	{
+		int32_t child = heapIdx * 2 + 1;
+		if (child >= arena.heapCount)
+		{
+			break;
+		}
+
+		if (child + 1 < arena.heapCount &&
+			arena.faces[arena.heap[child + 1]].distance < arena.faces[arena.heap[child]].distance)
+		{
+			++child;
+		}
+
+		int32_t childFace = arena.heap[child];
+		if (distance <= arena.faces[childFace].distance)
+		{
+			break;
+		}
 
-	// std::cout << "minNormal: " << minNormal.x << " " << minNormal.y << " " << minNormal.z << "\n";
-	// std::cout << "minDistance: " << minDistance << "\n";
+		arena.heap[heapIdx] = childFace;
+		arena.faces[childFace].heapIndex = heapIdx;
+		heapIdx = child;
+	}
 
-	// std::cout << "epa end!!\n";
-	return epaInfo;
+	arena.heap[heapIdx] = faceIdx;
+	arena.faces[faceIdx].heapIndex = heapIdx;
 }
 
-// simplex의 삼각형들의 법선벡터와 삼각형들중 원점에서 가장 멀리 떨어져있는 놈을 찾아서 반환
-int32_t Contact::getFaceNormals(SimplexArray &simplexArray, FaceArray &faceArray)
+// 지워지는 면의 edge를 추가
+// 반대 방향 edge가 이미 있으면 두 면이 공유하는 edge이므로 목록에서 제거
+void Contact::addHorizonEdge(EpaArena &arena, int32_t p1, int32_t p2)
 {
-	glm::vec3 center(0.0f);
-
-	int32_t simplexSize = simplexArray.simplexCount;
-	for (int32_t i = 0; i < simplexSize; ++i)
+	for (int32_t i = 0; i < arena.edgeCount; ++i)
 	{
-		center += simplexArray.simplices[i].diff;
+		if (arena.edges[i].first == p2 && arena.edges[i].second == p1)
+		{
+			--arena.edgeCount;
+			arena.edges[i] = arena.edges[arena.edgeCount];
+			return;
+		}
 	}
 
-	center = center / static_cast<float>(simplexSize);
+	arena.edges[arena.edgeCount].first = p1;
+	arena.edges[arena.edgeCount].second = p2;
+	++arena.edgeCount;
+}
 
-	// std::cout << " get Face Normals center : (" << center.x << ", " << center.y << ", " << center.z << ")\n";
+void Contact::generateManifolds(CollisionInfo &collisionInfo, Manifold &manifold, Fixture *m_fixtureA,
+								Fixture *m_fixtureB)
+{
+	/*
+		32bit id = 9bit(unused) 			|
+				   5bit(shape type A) 		|
+				   5bit(shape type B) 		|
+				   3bit(reference face of A)|
+				   5bit(feature of A) 		|
+				   5bit(feature of B)
+	*/
+	const Transform &transformA = m_fixtureA->getBody()->getTransform();
+	const Transform &transformB = m_fixtureB->getBody()->getTransform();
+	const glm::vec3 &centerA = m_fixtureA->getShape()->m_center;
+	const glm::vec3 &centerB = m_fixtureB->getShape()->m_center;
+	uint32_t typeId = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+					  (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+
+	int32_t collisionInfoSize = collisionInfo.size;
+	if (collisionInfoSize == 0)
+	{
+		manifold.pointsCount = 0;
+		return;
+	}
+
+	ManifoldPoint points[MAX_POLYGON_COUNT];
+	for (int32_t i = 0; i < collisionInfoSize; ++i)
+	{
+		points[i].pointA = collisionInfo.pointA[i];
+		points[i].pointB = collisionInfo.pointB[i];
+		points[i].normal = collisionInfo.normal[i];
+		points[i].seperation = collisionInfo.seperation[i];
+
+		uint32_t faceId = getFaceFeature(transformA, collisionInfo.normal[i]);
+		uint32_t featureA = getPointFeature(transformA, centerA, collisionInfo.pointA[i]);
+		uint32_t featureB = getPointFeature(transformB, centerB, collisionInfo.pointB[i]);
+		points[i].id = typeId | (faceId << 10) | (featureA << 5) | featureB;
+	}
 
-	int32_t minTriangle = 0;
-	float minDistance = FLT_MAX;
+	// clipping 결과를 MAX_MANIFOLD_COUNT개 이하로 줄여서 저장
+	int32_t pointsCount = reduceManifoldPoints(points, collisionInfoSize, collisionInfo.normal[0]);
+	std::copy(points, points + pointsCount, manifold.points);
+	manifold.pointsCount = pointsCount;
+}
 
-	// std::cout << "faces Size: " << faces.size() << "\n";
-	// 삼각형 순회
-	int32_t facesSize = faceArray.count * 3;
-	for (int32_t i = 0; i < facesSize; i = i + 3)
+// 두 구의 중심 거리로 접촉점 1개를 채우고, 겹치지 않으면 false
+bool Contact::setSphereContact(ManifoldPoint &manifoldPoint, const glm::vec3 &centerA, float radiusA,
+							   const glm::vec3 &centerB, float radiusB)
+{
+	glm::vec3 distance = centerB - centerA;
+	float length2 = glm::length2(distance);
+	float radius = radiusA + radiusB;
+	if (length2 >= radius * radius)
 	{
-		// 삼각형 꼭짓점들
-		glm::vec3 &a = simplexArray.simplices[faceArray.faces[i]].diff;
-		glm::vec3 &b = simplexArray.simplices[faceArray.faces[i + 1]].diff;
-		glm::vec3 &c = simplexArray.simplices[faceArray.faces[i + 2]].diff;
+		return false;
+	}
 
-		// std::cout << "pointA: " << a.x << " " << a.y << " " << a.z << "\n";
-		// std::cout << "pointB: " << b.x << " " << b.y << " " << b.z << "\n";
-		// std::cout << "pointC: " << c.x << " " << c.y << " " << c.z << "\n";
+	float length = std::sqrt(length2);
+	glm::vec3 normal = length > 1e-6f ? distance / length : glm::vec3(0.0f, 1.0f, 0.0f);
 
-		// 삼각형의 법선
-		glm::vec3 crossResult = glm::cross(b - a, c - a);
+	manifoldPoint.normal = normal;
+	manifoldPoint.seperation = radius - length;
+	manifoldPoint.pointA = centerA + normal * radiusA;
+	manifoldPoint.pointB = centerB - normal * radiusB;
+	return true;
+}
 
-		// face가 일직선일때 예외처리
-		// if (glm::length2(crossResult) == 0)
-		// {
-		// 	faces.erase(faces.begin() + i);
-		// 	faces.erase(faces.begin() + i);
-		// 	faces.erase(faces.begin() + i);
-		// 	i = i - 3;
-		// 	continue;
-		// }
+// setSphereContact를 SIMD_WIDTH개 쌍씩 한 번에 계산
+void Contact::computeSphereContacts(SphereBatch &batch)
+{
+	// 남는 lane은 닿지 않는 쌍(반지름 0, 같은 중심)으로 채움
+	int32_t paddedCount = (batch.count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+	for (int32_t i = batch.count; i < paddedCount; ++i)
+	{
+		batch.centerAX[i] = batch.centerAY[i] = batch.centerAZ[i] = batch.radiusA[i] = 0.0f;
+		batch.centerBX[i] = batch.centerBY[i] = batch.centerBZ[i] = batch.radiusB[i] = 0.0f;
+	}
 
-		glm::vec3 normal = glm::normalize(crossResult);
-		// std::cout  << "before normal: " << normal.x << " " << normal.y << " " << normal.z << "\n";
-		// 삼각형과 원점 사이의 거리
-		if (glm::dot(normal, a - center) < 0)
-		{
-			normal = -normal;
-		}
+	const SimdFloat zero = simdSet(0.0f);
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat epsilon = simdSet(1e-6f);
 
-		float distance = glm::dot(normal, a);
-		if (distance < 0)
+	for (int32_t i = 0; i < paddedCount; i = i + SIMD_WIDTH)
+	{
+		SimdFloat distanceX = simdLoad(batch.centerBX + i) - simdLoad(batch.centerAX + i);
+		SimdFloat distanceY = simdLoad(batch.centerBY + i) - simdLoad(batch.centerAY + i);
+		SimdFloat distanceZ = simdLoad(batch.centerBZ + i) - simdLoad(batch.centerAZ + i);
+		SimdFloat length2 = distanceX * distanceX + distanceY * distanceY + distanceZ * distanceZ;
+		SimdFloat radius = simdLoad(batch.radiusA + i) + simdLoad(batch.radiusB + i);
+		SimdFloat touching = simdLess(length2, radius * radius);
+
+		// 중심이 겹치면 normal은 (0, 1, 0)
+		SimdFloat length = simdSqrt(length2);
+		SimdFloat isValid = simdLess(epsilon, length);
+		// 역수를 곱하지 않고 나눠서 scalar 경로와 같은 값을 만듦
+		SimdFloat safeLength = simdMax(length, epsilon);
+
+		simdStore(batch.normalX + i, simdSelect(isValid, distanceX / safeLength, zero));
+		simdStore(batch.normalY + i, simdSelect(isValid, distanceY / safeLength, one));
+		simdStore(batch.normalZ + i, simdSelect(isValid, distanceZ / safeLength, zero));
+		simdStore(batch.seperation + i, radius - length);
+
+		int32_t mask = simdMoveMask(touching);
+		for (int32_t j = 0; j < SIMD_WIDTH; ++j)
 		{
-			return -1;
+			batch.isTouching[i + j] = ((mask >> j) & 1) != 0;
 		}
+	}
+}
 
-		// 법선 벡터 저장
-		faceArray.normals[i / 3] = glm::vec4(normal, distance);
+// computeSphereContacts 결과로 manifold를 채우고 updateManifold와 같이 마무리
+bool Contact::applySphereContact(const ManifoldReuseThreshold &reuseThreshold, const SphereBatch &batch, int32_t lane,
+								 uint32_t id)
+{
+	const Transform &transformA = m_fixtureA->getBody()->getTransform();
+	const Transform &transformB = m_fixtureB->getBody()->getTransform();
 
-		// 원점과 가장 가까운 삼각형 저장
-		if (distance < minDistance)
-		{
-			minTriangle = i / 3;
-			minDistance = distance;
-		}
+	int32_t oldPointsCount = m_manifold.pointsCount;
+	ManifoldPoint oldPoints[MAX_MANIFOLD_COUNT];
+	std::copy(m_manifold.points, m_manifold.points + oldPointsCount, oldPoints);
+
+	m_manifold.pointsCount = 0;
+	if (batch.isTouching[lane])
+	{
+		glm::vec3 normal(batch.normalX[lane], batch.normalY[lane], batch.normalZ[lane]);
+		glm::vec3 centerA(batch.centerAX[lane], batch.centerAY[lane], batch.centerAZ[lane]);
+		glm::vec3 centerB(batch.centerBX[lane], batch.centerBY[lane], batch.centerBZ[lane]);
+
+		ManifoldPoint &manifoldPoint = m_manifold.points[0];
+		manifoldPoint.normal = normal;
+		manifoldPoint.seperation = batch.seperation[lane];
+		manifoldPoint.pointA = centerA + normal * batch.radiusA[lane];
+		manifoldPoint.pointB = centerB - normal * batch.radiusB[lane];
+		manifoldPoint.id = id;
+		m_manifold.pointsCount = 1;
 	}
 
-	return minTriangle;
+	return finishManifold(reuseThreshold, oldPoints, oldPointsCount, transformA, transformB);
 }
 
-void Contact::addIfUniqueEdge(UniqueEdges &uniqueEdges, const int32_t *faces, int32_t p1, int32_t p2)
+// 접촉점이 4개보다 많으면 가장 깊은 점, 그 점에서 가장 먼 점,
+// 두 점을 잇는 선분 양쪽으로 가장 넓은 삼각형을 만드는 점을 골라 앞쪽 4개로 정리
+int32_t Contact::reduceManifoldPoints(ManifoldPoint *points, int32_t pointsCount, const glm::vec3 &normal)
 {
-	int32_t size = uniqueEdges.size;
-	int32_t i = 0;
-	bool removeEdge = false;
-	for (; i < size; ++i)
+	if (pointsCount <= MAX_MANIFOLD_COUNT)
+	{
+		return pointsCount;
+	}
+
+	int32_t indices[MAX_MANIFOLD_COUNT];
+
+	indices[0] = 0;
+	for (int32_t i = 1; i < pointsCount; ++i)
 	{
-		std::pair<int32_t, int32_t> &edge = uniqueEdges.edges[i];
-		if (edge.first == faces[p2] && edge.second == faces[p1])
+		if (points[i].seperation > points[indices[0]].seperation)
 		{
-			removeEdge = true;
-			++i;
-			break;
+			indices[0] = i;
 		}
 	}
 
-	for (; i < size; ++i)
+	const glm::vec3 &first = points[indices[0]].pointA;
+	float maxDistance = -1.0f;
+	indices[1] = indices[0];
+	for (int32_t i = 0; i < pointsCount; ++i)
 	{
-		uniqueEdges.edges[i - 1] = uniqueEdges.edges[i];
+		float distance = glm::length2(points[i].pointA - first);
+		if (distance > maxDistance)
+		{
+			maxDistance = distance;
+			indices[1] = i;
+		}
 	}
 
-	if (removeEdge)
+	const glm::vec3 &second = points[indices[1]].pointA;
+	float maxArea = 0.0f;
+	float minArea = 0.0f;
+	indices[2] = indices[0];
+	indices[3] = indices[1];
+	for (int32_t i = 0; i < pointsCount; ++i)
 	{
-		--uniqueEdges.size;
+		float area = glm::dot(glm::cross(first - points[i].pointA, second - points[i].pointA), normal);
+		if (area > maxArea)
+		{
+			maxArea = area;
+			indices[2] = i;
+		}
+		else if (area < minArea)
+		{
+			minArea = area;
+			indices[3] = i;
+		}
 	}
-	else
+
+	ManifoldPoint reduced[MAX_MANIFOLD_COUNT];
+	int32_t reducedCount = 0;
+	for (int32_t i = 0; i < MAX_MANIFOLD_COUNT; ++i)
 	{
-		uniqueEdges.edges[uniqueEdges.size] = std::make_pair(faces[p1], faces[p2]);
-		++uniqueEdges.size;
+		bool isDuplicated = false;
+		for (int32_t j = 0; j < i; ++j)
+		{
+			if (indices[j] == indices[i])
+			{
+				isDuplicated = true;
+				break;
+			}
+		}
+
+		if (isDuplicated == false)
+		{
+			reduced[reducedCount] = points[indices[i]];
+			++reducedCount;
+		}
 	}
+
+	std::copy(reduced, reduced + reducedCount, points);
+	return reducedCount;
 }
 
-void Contact::generateManifolds(CollisionInfo &collisionInfo, Manifold &manifold, Fixture *m_fixtureA,
-								Fixture *m_fixtureB)
+// 로컬 공간 normal의 가장 큰 성분 축과 부호로 면 번호(0 ~ 5) 결정
+uint32_t Contact::getFaceFeature(const Transform &transform, const glm::vec3 &normal)
 {
-	/*
-		64bit = 27bit(small proxyId) 	 |
-				27bit(big proxyId) 		 |
-				5bit(small contact part) |
-				5bit(big contact part)
-	*/
-	// static int64_t bitmask = 0xFFFFFFFF & ~0b11111;
-
-	int32_t collisionInfoSize = collisionInfo.size;
-	manifold.pointsCount = collisionInfoSize;
+	glm::vec3 localNormal = glm::inverse(transform.orientation) * normal;
+	glm::vec3 absNormal = glm::abs(localNormal);
 
-	for (int32_t i = 0; i < collisionInfoSize; ++i)
+	uint32_t axis = 0;
+	if (absNormal.y > absNormal[axis])
+	{
+		axis = 1;
+	}
+	if (absNormal.z > absNormal[axis])
 	{
-		manifold.points[i].pointA = collisionInfo.pointA[i];
-		manifold.points[i].pointB = collisionInfo.pointB[i];
-		manifold.points[i].normal = collisionInfo.normal[i];
-		manifold.points[i].seperation = collisionInfo.seperation[i];
+		axis = 2;
+	}
+
+	return axis * 2 + (localNormal[axis] < 0.0f ? 1 : 0);
+}
 
-		// int64_t proxyIdA = m_fixtureA->getFixtureProxy()->proxyId;
-		// int64_t proxyIdB = m_fixtureB->getFixtureProxy()->proxyId;
+// 도형 중심 기준 로컬 좌표의 축별 부호(-, 0, +)를 3진수로 압축 (0 ~ 26)
+// 실제 vertex / edge / face index가 아니라 위치로 추정한 값, |p|의 0.3배 이내 성분은 0으로 취급
+// 성분이 그 경계 근처에 있으면 step마다 값이 바뀌어 warm start 매칭이 끊길 수 있음
+uint32_t Contact::getPointFeature(const Transform &transform, const glm::vec3 &center, const glm::vec3 &point)
+{
+	const float threshold = 0.3f; // 중심 거리 대비 이 비율보다 작은 성분은 0으로 취급
 
-		// if (proxyIdA > proxyIdB)
-		// {
-		// 	int64_t tmp = proxyIdA;
-		// 	proxyIdA = proxyIdB;
-		// 	proxyIdB = tmp;
-		// }
+	glm::vec3 localPoint = glm::inverse(transform.orientation) * (point - transform.position) - center;
+	float zeroRange = glm::length(localPoint) * threshold;
 
-		// proxyIdA = (proxyIdA << 5) & bitmask;
-		// proxyIdB = (proxyIdB << 5) & bitmask;
-		// manifoldPoint.id = (proxyIdA << 32) | (proxyIdB << 10);
+	uint32_t feature = 0;
+	for (int32_t axis = 2; axis >= 0; --axis)
+	{
+		uint32_t digit = 1;
+		if (localPoint[axis] > zeroRange)
+		{
+			digit = 2;
+		}
+		else if (localPoint[axis] < -zeroRange)
+		{
+			digit = 0;
+		}
+		feature = feature * 3 + digit;
 	}
+
+	return feature;
 }
 
 void Contact::buildManifoldFromPolygon(CollisionInfo &collisionInfo, const Face &refFace, const Face &incFace,
@@ -1090,182 +1561,113 @@ void Contact::sortVerticesClockwise(glm::vec3 *vertices, const glm::vec3 &center
 
 void Contact::setBoxFace(Face &face, const ConvexInfo &box, const glm::vec3 &normal)
 {
-	// 1) box의 6개 면 중, worldNormal과 가장 유사한 면( dot > 0 ) 찾기
-	// 2) 그 면의 4개 꼭지점을 구함
-	// 여기서는 '법선이 박스의 +Y축과 가장 가까우면 top face' 식으로 단순화 예시
-	// 실제 구현은 회전/transform 고려해야 함
-
-	glm::vec3 axes[6] = {-box.axes[0], -box.axes[1], -box.axes[2], box.axes[0], box.axes[1], box.axes[2]};
-
+	// box의 6개 면 중 normal과 가장 유사한 면을 찾고
+	// 면 중심에서 나머지 두 축 방향으로 halfSize만큼 이동한 4개의 꼭지점을 구함
+	int32_t maxIdx = 0;
 	float maxDotRes = -FLT_MAX;
-	int32_t maxIdx = -1;
-	for (int32_t i = 0; i < 6; i++)
+	for (int32_t i = 0; i < 3; ++i)
 	{
-		float nowDotRes = glm::dot(axes[i], normal);
-		if (nowDotRes > maxDotRes)
+		float nowDotRes = glm::dot(box.axes[i], normal);
+		if (std::abs(nowDotRes) > maxDotRes)
 		{
-			maxDotRes = nowDotRes;
+			maxDotRes = std::abs(nowDotRes);
 			maxIdx = i;
 		}
 	}
 
-	glm::vec3 axis = axes[maxIdx];
-	float centerDotRes = glm::dot(box.center, axis);
-	glm::vec3 center(0.0f);
+	float sign = glm::dot(box.axes[maxIdx], normal) < 0.0f ? -1.0f : 1.0f;
+	glm::vec3 axis = box.axes[maxIdx] * sign;
+	glm::vec3 center = box.center + axis * box.halfSize[maxIdx];
 
-	int32_t pointCount = box.pointsCount;
-	int32_t idx = 0;
-	for (int32_t i = 0; i < pointCount; ++i)
-	{
-		glm::vec3 &point = box.points[i];
-		if (glm::dot(point, axis) > centerDotRes)
-		{
-			center += point;
-			face.vertices[idx] = point;
-			++idx;
-		}
-	}
+	int32_t idx1 = (maxIdx + 1) % 3;
+	int32_t idx2 = (maxIdx + 2) % 3;
+	glm::vec3 u = box.axes[idx1] * box.halfSize[idx1];
+	glm::vec3 v = box.axes[idx2] * box.halfSize[idx2];
 
-	center = glm::vec3((center.x / idx), (center.y / idx), (center.z / idx));
-	face.verticesCount = idx;
+	face.vertices[0] = center + u + v;
+	face.vertices[1] = center - u + v;
+	face.vertices[2] = center - u - v;
+	face.vertices[3] = center + u - v;
+	face.verticesCount = 4;
 	face.normal = axis;
-	face.distance = glm::dot(axis, face.vertices[0]);
+	face.distance = glm::dot(axis, center);
 
 	sortVerticesClockwise(face.vertices, center, face.normal, face.verticesCount);
 }
 
 void Contact::setCylinderFace(Face &face, const ConvexInfo &cylinder, const glm::vec3 &normal)
 {
-	glm::vec3 center;
 	int32_t segments = 20;
-	float length = glm::dot(normal, cylinder.axes[0]);
 	float angleStep = 2.0f * glm::pi<float>() / static_cast<float>(segments);
+	float length = glm::dot(normal, cylinder.axes[0]);
 
-	float limit = glm::dot(cylinder.axes[0], glm::normalize(cylinder.points[0] - cylinder.center));
+	// 윗면 테두리 점과 중심을 잇는 방향이 축과 이루는 cos 값
+	float halfHeight = cylinder.height * 0.5f;
+	float limit = halfHeight / std::sqrt(halfHeight * halfHeight + cylinder.radius * cylinder.radius);
 
-	if (length > limit)
+	if (length > limit || length < -limit)
 	{
-		face.verticesCount = segments;
-		int32_t len = segments;
-		for (int32_t i = 0; i < len; ++i)
-		{
-			face.vertices[i] = cylinder.points[i];
-		}
+		float sign = length > 0.0f ? 1.0f : -1.0f;
+		glm::vec3 center = cylinder.center + cylinder.axes[0] * (sign * halfHeight);
 
-		center = cylinder.center + cylinder.axes[0] * cylinder.height * 0.5f;
-		face.normal = cylinder.axes[0];
-		face.distance = glm::dot(cylinder.axes[0], face.vertices[0]);
-	}
-	else if (length < -limit)
-	{
 		face.verticesCount = segments;
-		int32_t len = segments * 2;
-		for (int32_t i = segments; i < len; ++i)
+		for (int32_t i = 0; i < segments; ++i)
 		{
-			face.vertices[i - segments] = cylinder.points[i];
+			float theta = i * angleStep;
+			face.vertices[i] = center + (cylinder.axes[1] * std::cos(theta) + cylinder.axes[2] * std::sin(theta)) *
+											cylinder.radius;
 		}
 
-		center = cylinder.center - cylinder.axes[0] * cylinder.height * 0.5f;
-		face.normal = -cylinder.axes[0];
-		face.distance = glm::dot(-cylinder.axes[0], face.vertices[0]);
-		// std::cout << "distance: " << face.distance << "\n";
+		face.normal = cylinder.axes[0] * sign;
+		face.distance = glm::dot(face.normal, center);
+
+		sortVerticesClockwise(face.vertices, center, face.normal, face.verticesCount);
 	}
 	else
 	{
-		// std::cout << "edge!!!\n";
-		face.normal = normal;
-		float dotResult = glm::dot(normal, cylinder.axes[0]);
-		if (dotResult != 0.0f)
-		{
-			face.normal = glm::normalize(normal - dotResult * cylinder.axes[0]);
-		}
-
-		int32_t dir;
-		float max = -FLT_MAX;
-		// std::cout << "face.normal: (" << face.normal.x << ", " << face.normal.y << ", " << face.normal.z <<")\n";
-
-		for (int32_t i = 1; i <= segments; ++i)
-		{
-			dotResult = glm::dot(cylinder.axes[i], face.normal);
-			if (dotResult > max)
-			{
-				// std::cout << "max!!\n";
-				// std::cout << "dotResult: " << dotResult <<" \n";
-				// std::cout << "axes[" << i << "]: (" << cylinder.axes[i].x << ", " << cylinder.axes[i].y << ", " <<
-				// cylinder.axes[i].z <<")\n";
-				dir = i;
-				max = dotResult;
-			}
-		}
-
-		int32_t idx1 = dir - 1;
-		int32_t idx2 = dir % segments;
-
-		face.verticesCount = 4;
-		face.vertices[0] = cylinder.points[idx1];
-		face.vertices[1] = cylinder.points[idx2];
-		face.vertices[2] = cylinder.points[idx1 + segments];
-		face.vertices[3] = cylinder.points[idx2 + segments];
-		// std::cout << "face 4 start\n";
-		// for (int i = 0; i < 4; i ++)
-		// {
-		// std::cout << "face[" << i << "]: (" << face.vertices[i].x << ", " << face.vertices[i].y << ", " <<
-		// face.vertices[i].z <<")\n";
-		// }
-
-		face.distance = glm::dot(face.normal, face.vertices[0]);
-		center = (face.vertices[0] + face.vertices[1] + face.vertices[2] + face.vertices[3]) / 4.0f;
+		setSideFace(face, cylinder, normal);
 	}
-
-	sortVerticesClockwise(face.vertices, center, face.normal, face.verticesCount);
 }
 
 void Contact::setCapsuleFace(Face &face, const ConvexInfo &capsule, const glm::vec3 &normal)
+{
+	setSideFace(face, capsule, normal);
+}
+
+// 옆면을 20각 기둥으로 근사했을 때 normal 방향의 옆면 사각형
+void Contact::setSideFace(Face &face, const ConvexInfo &convex, const glm::vec3 &normal)
 {
 	int32_t segments = 20;
 	float angleStep = 2.0f * glm::pi<float>() / static_cast<float>(segments);
 
 	face.normal = normal;
-	float dotResult = glm::dot(normal, capsule.axes[0]);
-
+	float dotResult = glm::dot(normal, convex.axes[0]);
 	if (dotResult != 0.0f)
 	{
-		face.normal = glm::normalize(normal - dotResult * capsule.axes[0]);
+		face.normal = glm::normalize(normal - dotResult * convex.axes[0]);
 	}
 
-	int32_t dir;
-	float max = -FLT_MAX;
-	// std::cout << "face.normal: (" << face.normal.x << ", " << face.normal.y << ", " << face.normal.z <<")\n";
-
-	for (int32_t i = 1; i <= segments; ++i)
+	// normal의 각도가 속한 구간 [k * step, (k + 1) * step)의 옆면 선택
+	float angle = std::atan2(glm::dot(face.normal, convex.axes[2]), glm::dot(face.normal, convex.axes[1]));
+	if (angle < 0.0f)
 	{
-		dotResult = glm::dot(capsule.axes[i], face.normal);
-		if (dotResult > max)
-		{
-			// std::cout << "max!!\n";
-			// std::cout << "dotResult: " << dotResult <<" \n";
-			// std::cout << "axes[" << i << "]: (" << capsule.axes[i].x << ", " << capsule.axes[i].y << ", " <<
-			// capsule.axes[i].z <<")\n";
-			dir = i;
-			max = dotResult;
-		}
+		angle += 2.0f * glm::pi<float>();
 	}
 
-	int32_t idx1 = dir - 1;
-	int32_t idx2 = dir % segments;
+	int32_t k = static_cast<int32_t>(angle / angleStep) % segments;
+	float theta1 = k * angleStep;
+	float theta2 = (k + 1) * angleStep;
+
+	glm::vec3 dir1 = (convex.axes[1] * std::cos(theta1) + convex.axes[2] * std::sin(theta1)) * convex.radius;
+	glm::vec3 dir2 = (convex.axes[1] * std::cos(theta2) + convex.axes[2] * std::sin(theta2)) * convex.radius;
+	glm::vec3 top = convex.center + convex.axes[0] * (convex.height * 0.5f);
+	glm::vec3 bottom = convex.center - convex.axes[0] * (convex.height * 0.5f);
 
 	face.verticesCount = 4;
-	face.vertices[0] = capsule.points[idx1];
-	face.vertices[1] = capsule.points[idx2];
-	face.vertices[2] = capsule.points[idx1 + segments];
-	face.vertices[3] = capsule.points[idx2 + segments];
-
-	// std::cout << "face 4 start\n";
-	// for (int i = 0; i < 4; i ++)
-	// {
-	// std::cout << "face[" << i << "]: (" << face.vertices[i].x << ", " << face.vertices[i].y << ", " <<
-	// face.vertices[i].z <<")\n";
-	// }
+	face.vertices[0] = top + dir1;
+	face.vertices[1] = top + dir2;
+	face.vertices[2] = bottom + dir1;
+	face.vertices[3] = bottom + dir2;
 
 	face.distance = glm::dot(face.normal, face.vertices[0]);
 	glm::vec3 center = (face.vertices[0] + face.vertices[1] + face.vertices[2] + face.vertices[3]) / 4.0f;
@@ -1279,84 +1681,16 @@ bool Contact::isCollideToHemisphere(const ConvexInfo &capsule, const glm::vec3 &
 	return dotResult > 0.0001f || dotResult < -0.0001f;
 }
 
-void Contact::addFaceInFaceArray(FaceArray &faceArray, int32_t idx1, int32_t idx2, int32_t idx3)
-{
-	int32_t count = faceArray.count;
-	int32_t faceIdx = count * 3;
-
-	if (count >= faceArray.maxCount)
-	{
-		sizeUpFaceArray(faceArray, count * 2);
-	}
-
-	faceArray.faces[faceIdx] = idx1;
-	faceArray.faces[faceIdx + 1] = idx2;
-	faceArray.faces[faceIdx + 2] = idx3;
-	++faceArray.count;
-}
-
-void Contact::mergeFaceArray(FaceArray &faceArray, FaceArray &newFaceArray)
-{
-	int32_t faceArrayCount = faceArray.count;
-	int32_t newFaceArrayCount = newFaceArray.count;
-	int32_t newCount = newFaceArrayCount + faceArrayCount;
-
-	if (newCount > faceArray.maxCount)
-	{
-		int32_t newMaxCount = faceArrayCount;
-		while (newMaxCount < newCount)
-		{
-			newMaxCount = newMaxCount * 2;
-		}
-
-		sizeUpFaceArray(faceArray, newMaxCount);
-	}
-
-	memcpy(faceArray.faces + faceArrayCount * 3, newFaceArray.faces, sizeof(int32_t) * newFaceArrayCount * 3);
-	memcpy(faceArray.normals + faceArrayCount, newFaceArray.normals, sizeof(glm::vec4) * newFaceArrayCount);
-
-	faceArray.count = newCount;
-}
-
-void Contact::sizeUpFaceArray(FaceArray &faceArray, int32_t newMaxCount)
-{
-	int32_t count = faceArray.count;
-	void *memory = PhysicsAllocator::m_blockAllocator.allocateBlock(3 * newMaxCount * sizeof(int32_t));
-	int32_t *newFaces = static_cast<int32_t *>(memory);
-	memcpy(newFaces, faceArray.faces, sizeof(int32_t) * count * 3);
-
-	memory = PhysicsAllocator::m_blockAllocator.allocateBlock(newMaxCount * sizeof(glm::vec4));
-	glm::vec4 *newNormals = static_cast<glm::vec4 *>(memory);
-	memcpy(newNormals, faceArray.normals, sizeof(glm::vec4) * count);
-
-	PhysicsAllocator::m_blockAllocator.freeBlock(faceArray.faces, sizeof(int32_t) * faceArray.maxCount * 3);
-	PhysicsAllocator::m_blockAllocator.freeBlock(faceArray.normals, sizeof(glm::vec4) * faceArray.maxCount);
-
-	faceArray.maxCount = newMaxCount;
-	faceArray.faces = newFaces;
-	faceArray.normals = newNormals;
-}
-
-void Contact::freeConvexInfo(ConvexInfo &convexA, ConvexInfo &convexB)
-{
-	if (convexA.points != nullptr)
-	{
-		PhysicsAllocator::m_blockAllocator.freeBlock(convexA.points, sizeof(glm::vec3) * convexA.pointsCount);
-	}
-	if (convexB.points != nullptr)
-	{
-		PhysicsAllocator::m_blockAllocator.freeBlock(convexB.points, sizeof(glm::vec3) * convexB.pointsCount);
-	}
-
-	if (convexA.axes != nullptr)
-	{
-		PhysicsAllocator::m_blockAllocator.freeBlock(convexA.axes, sizeof(glm::vec3) * convexA.axesCount);
-	}
-
-	if (convexB.axes != nullptr)
-	{
-		PhysicsAllocator::m_blockAllocator.freeBlock(convexB.axes, sizeof(glm::vec3) * convexB.axesCount);
-	}
-}
+// GJK/EPA를 사용하는 contact의 shape 조합
+template void Contact::evaluateConvex<SphereShape, CylinderShape>(Manifold &manifold, const Transform &transformA,
+																  const Transform &transformB);
+template void Contact::evaluateConvex<BoxShape, CylinderShape>(Manifold &manifold, const Transform &transformA,
+															   const Transform &transformB);
+template void Contact::evaluateConvex<BoxShape, CapsuleShape>(Manifold &manifold, const Transform &transformA,
+															  const Transform &transformB);
+template void Contact::evaluateConvex<CylinderShape, CylinderShape>(Manifold &manifold, const Transform &transformA,
+																	const Transform &transformB);
+template void Contact::evaluateConvex<CylinderShape, CapsuleShape>(Manifold &manifold, const Transform &transformA,
+																   const Transform &transformB);
 
 } // namespace ale
\ No newline at end of file
@@ -3,10 +3,16 @@
 
 namespace ale
 {
+const int32_t ContactManager::COLLIDE_CHUNK_SIZE = 32;
+
 ContactManager::ContactManager()
 {
 	m_contactCount = 0;
 	m_contactList = nullptr;
+	m_contactListener = nullptr;
+	m_taskScheduler = nullptr;
+	m_reuseThreshold.linear = 0.0f;
+	m_reuseThreshold.angular = 0.0f;
 }
 
 bool ContactManager::isSameContact(ContactLink *link, Fixture *fixtureA, Fixture *fixtureB, int32_t indexA,
@@ -137,18 +143,188 @@ void ContactManager::findNewContacts()
 
 void ContactManager::collide()
 {
+	// contactList를 배열로 모아 두고 나눠서 처리
+	// broadphase는 새로 겹친 pair만 알려주므로 떨어졌던 contact도 매 step 다시 검사
+	m_contactUpdates.clear();
 	Contact *contact = m_contactList;
-
-	// contactList 순회
 	while (contact)
 	{
-		// 실제 충돌 여부를 검사하고 해당 충돌 정보인 manifold 생성
-		if (contact->hasFlag(EContactFlag::TOUCHING))
+		Fixture *fixtureA = contact->getFixtureA();
+		Fixture *fixtureB = contact->getFixtureB();
+		int32_t proxyIdA = fixtureA->getFixtureProxy()[contact->getChildIndexA()].proxyId;
+		int32_t proxyIdB = fixtureB->getFixtureProxy()[contact->getChildIndexB()].proxyId;
+
+		// fat AABB가 더 이상 겹치지 않으면 contact 제거
+		// 다시 겹치게 되면 broadphase가 새 pair로 알려줌
+		if (m_broadPhase.testOverlap(proxyIdA, proxyIdB) == false)
 		{
-			contact->update();
+			Contact *next = contact->getNext();
+			destroy(contact);
+			contact = next;
+			continue;
 		}
+
+		// 실제 충돌 여부를 검사하고 해당 충돌 정보인 manifold 생성
+		m_contactUpdates.push_back({contact, contact->getPairType(), contact->getManifold().pointsCount > 0, false});
 		contact = contact->getNext();
 	}
+
+	int32_t updateCount = static_cast<int32_t>(m_contactUpdates.size());
+
+	// pair type별로 묶은 순서 (counting sort)
+	// 같은 type이 연속되도록 해서 type마다 고정된 kernel로 처리
+	int32_t typeOffsets[33] = {};
+	for (const ContactUpdate &contactUpdate : m_contactUpdates)
+	{
+		++typeOffsets[contactUpdate.pairType + 1];
+	}
+	for (int32_t i = 0; i < 32; ++i)
+	{
+		typeOffsets[i + 1] += typeOffsets[i];
+	}
+
+	m_updateOrder.resize(updateCount);
+	for (int32_t i = 0; i < updateCount; ++i)
+	{
+		m_updateOrder[typeOffsets[m_contactUpdates[i].pairType]++] = i;
+	}
+	int32_t chunkCount = (updateCount + COLLIDE_CHUNK_SIZE - 1) / COLLIDE_CHUNK_SIZE;
+
+	if (m_taskScheduler == nullptr || chunkCount <= 1)
+	{
+		updateContacts(0, updateCount);
+	}
+	else
+	{
+		// 각 contact는 자기 manifold에만 쓰므로 동시에 갱신 가능
+		m_taskScheduler->parallelFor(chunkCount, [this, updateCount](int32_t index, int32_t) {
+			int32_t begin = index * COLLIDE_CHUNK_SIZE;
+			int32_t end = std::min(begin + COLLIDE_CHUNK_SIZE, updateCount);
+			updateContacts(begin, end);
+		});
+	}
+
+	commitContacts();
+}
+
+// world contact list와 양쪽 body의 contact link에서 떼어낸 뒤 메모리 반환
+void ContactManager::destroy(Contact *contact)
+{
+	if (m_contactListener != nullptr && contact->getManifold().pointsCount > 0)
+	{
+		m_contactListener->endContact(contact);
+	}
+
+	Rigidbody *bodyA = contact->getFixtureA()->getBody();
+	Rigidbody *bodyB = contact->getFixtureB()->getBody();
+
+	// world contactList에서 제거
+	if (contact->getPrev() != nullptr)
+	{
+		contact->getPrev()->setNext(contact->getNext());
+	}
+	if (contact->getNext() != nullptr)
+	{
+		contact->getNext()->setPrev(contact->getPrev());
+	}
+	if (contact == m_contactList)
+	{
+		m_contactList = contact->getNext();
+	}
+
+	// bodyA의 contactLinks에서 제거
+	ContactLink *nodeA = contact->getNodeA();
+	if (nodeA->prev != nullptr)
+	{
+		nodeA->prev->next = nodeA->next;
+	}
+	if (nodeA->next != nullptr)
+	{
+		nodeA->next->prev = nodeA->prev;
+	}
+	if (nodeA == bodyA->getContactLinks())
+	{
+		bodyA->setContactLinks(nodeA->next);
+	}
+
+	// bodyB의 contactLinks에서 제거
+	ContactLink *nodeB = contact->getNodeB();
+	if (nodeB->prev != nullptr)
+	{
+		nodeB->prev->next = nodeB->next;
+	}
+	if (nodeB->next != nullptr)
+	{
+		nodeB->next->prev = nodeB->prev;
+	}
+	if (nodeB == bodyB->getContactLinks())
+	{
+		bodyB->setContactLinks(nodeB->next);
+	}
+
+	Contact::destroy(contact);
+	--m_contactCount;
+}
+
+// m_updateOrder[begin, end) 안에서 같은 pair type이 이어진 구간마다 해당 type의 kernel 호출
+void ContactManager::updateContacts(int32_t begin, int32_t end)
+{
+	int32_t i = begin;
+	while (i < end)
+	{
+		int32_t pairType = m_contactUpdates[m_updateOrder[i]].pairType;
+		int32_t j = i + 1;
+		while (j < end && m_contactUpdates[m_updateOrder[j]].pairType == pairType)
+		{
+			++j;
+		}
+
+		Contact::updateBatch(pairType, m_contactUpdates.data(), m_updateOrder.data() + i, j - i, m_reuseThreshold);
+		i = j;
+	}
+}
+
+// flag 변경과 충돌 이벤트는 contactList 순서대로 한 스레드에서 반영
+void ContactManager::commitContacts()
+{
+	for (ContactUpdate &contactUpdate : m_contactUpdates)
+	{
+		Contact *contact = contactUpdate.contact;
+
+		if (contactUpdate.touching)
+		{
+			contact->setFlag(EContactFlag::TOUCHING);
+		}
+		else
+		{
+			contact->unsetFlag(EContactFlag::TOUCHING);
+		}
+
+		if (m_contactListener == nullptr)
+		{
+			continue;
+		}
+
+		if (contactUpdate.touching && contactUpdate.wasTouching == false)
+		{
+			m_contactListener->beginContact(contact);
+		}
+		else if (contactUpdate.touching == false && contactUpdate.wasTouching)
+		{
+			m_contactListener->endContact(contact);
+		}
+	}
+}
+
+void ContactManager::setManifoldReuseThreshold(float linearThreshold, float angularThreshold)
+{
+	m_reuseThreshold.linear = linearThreshold;
+	m_reuseThreshold.angular = angularThreshold;
+}
+
+void ContactManager::setTaskScheduler(TaskScheduler *scheduler)
+{
+	m_taskScheduler = scheduler;
 }
 
 } // namespace ale
@@ -7,18 +7,21 @@ const float ContactSolver::NORMAL_STOP_VELOCITY = 0.0001f;
 const float ContactSolver::TANGENT_STOP_VELOCITY = 0.0001f;
 const float ContactSolver::NORMAL_SLEEP_VELOCITY = 1.0f;
 const float ContactSolver::TANGENT_SLEEP_VELOCITY = 1.0f;
+const float ContactSolver::RESTITUTION_VELOCITY = 1.0f;
+const int32_t ContactSolver::COLOR_CHUNK_SIZE = 16;
+const int32_t ContactSolver::MIN_PARALLEL_COLOR_SIZE = 64;
 
-ContactSolver::ContactSolver(float duration, Contact **contacts, Position *positions, Velocity *velocities,
-							 int32_t bodyCount, int32_t contactCount)
+ContactSolver::ContactSolver(float duration, Contact **contacts, ContactBodyIndex *contactIndices, Position *positions,
+							 Velocity *velocities, int32_t bodyCount, int32_t contactCount, StackAllocator &allocator)
 	: m_duration(duration), m_positions(positions), m_velocities(velocities), m_contacts(contacts),
-	  m_bodyCount(bodyCount), m_contactCount(contactCount)
+	  m_bodyCount(bodyCount), m_contactCount(contactCount), m_allocator(allocator), m_colorContacts(nullptr)
 {
 	// std::cout << "ContactSolver Constructor\n";
 	// std::cout << "constactCount: " << contactCount << "\n";
 	m_positionConstraints = static_cast<ContactPositionConstraint *>(
-		PhysicsAllocator::m_stackAllocator.allocateStack(sizeof(ContactPositionConstraint) * contactCount));
+		m_allocator.allocateStack(sizeof(ContactPositionConstraint) * contactCount));
 	m_velocityConstraints = static_cast<ContactVelocityConstraint *>(
-		PhysicsAllocator::m_stackAllocator.allocateStack(sizeof(ContactVelocityConstraint) * contactCount));
+		m_allocator.allocateStack(sizeof(ContactVelocityConstraint) * contactCount));
 
 	for (int32_t i = 0; i < contactCount; i++)
 	{
@@ -41,8 +44,8 @@ ContactSolver::ContactSolver(float duration, Contact **contacts, Position *posit
 		m_velocityConstraints[i].restitution = contact->getRestitution();
 		m_velocityConstraints[i].worldCenterA = bodyA->getTransform().toMatrix() * glm::vec4(shapeA->m_center, 1.0f);
 		m_velocityConstraints[i].worldCenterB = bodyB->getTransform().toMatrix() * glm::vec4(shapeB->m_center, 1.0f);
-		m_velocityConstraints[i].indexA = bodyA->getIslandIndex();
-		m_velocityConstraints[i].indexB = bodyB->getIslandIndex();
+		m_velocityConstraints[i].indexA = contactIndices[i].indexA;
+		m_velocityConstraints[i].indexB = contactIndices[i].indexB;
 		m_velocityConstraints[i].invMassA = bodyA->getInverseMass();
 		m_velocityConstraints[i].invMassB = bodyB->getInverseMass();
 		m_velocityConstraints[i].invIA = bodyA->getInverseInertiaTensorWorld();
@@ -53,8 +56,8 @@ ContactSolver::ContactSolver(float duration, Contact **contacts, Position *posit
 		// 위치 제약 설정
 		m_positionConstraints[i].worldCenterA = bodyA->getTransform().toMatrix() * glm::vec4(shapeA->m_center, 1.0f);
 		m_positionConstraints[i].worldCenterB = bodyB->getTransform().toMatrix() * glm::vec4(shapeB->m_center, 1.0f);
-		m_positionConstraints[i].indexA = bodyA->getIslandIndex();
-		m_positionConstraints[i].indexB = bodyB->getIslandIndex();
+		m_positionConstraints[i].indexA = contactIndices[i].indexA;
+		m_positionConstraints[i].indexB = contactIndices[i].indexB;
 		m_positionConstraints[i].invMassA = bodyA->getInverseMass();
 		m_positionConstraints[i].invMassB = bodyB->getInverseMass();
 		m_velocityConstraints[i].invIA = bodyA->getInverseInertiaTensorWorld();
@@ -66,335 +69,464 @@ ContactSolver::ContactSolver(float duration, Contact **contacts, Position *posit
 
 void ContactSolver::destroy()
 {
+	if (m_colorContacts != nullptr)
+	{
+		m_allocator.freeStack();
+		m_colorContacts = nullptr;
+	}
+
 	for (int32_t i = 0; i < m_contactCount; i++)
 	{
 		m_positionConstraints[i].~ContactPositionConstraint();
 		m_velocityConstraints[i].~ContactVelocityConstraint();
 	}
 
-	PhysicsAllocator::m_stackAllocator.freeStack();
-	PhysicsAllocator::m_stackAllocator.freeStack();
+	m_allocator.freeStack();
+	m_allocator.freeStack();
 }
 
-void ContactSolver::solveVelocityConstraints()
+// 반복 전 속도를 기준으로 반발 목표 속도 계산
+// 느린 충돌까지 튕기면 쌓인 물체가 계속 떨리므로 RESTITUTION_VELOCITY 이상일 때만 반발
+void ContactSolver::initializeVelocityConstraints()
 {
 	for (int32_t i = 0; i < m_contactCount; i++)
 	{
-		Contact *contact = m_contacts[i];
 		ContactVelocityConstraint &velocityConstraint = m_velocityConstraints[i];
-		int32_t pointCount = velocityConstraint.pointCount;
-		int32_t indexA = velocityConstraint.indexA;
-		int32_t indexB = velocityConstraint.indexB;
+		const Velocity &velocityA = m_velocities[velocityConstraint.indexA];
+		const Velocity &velocityB = m_velocities[velocityConstraint.indexB];
 
-		glm::vec3 &linearVelocityA = m_velocities[indexA].linearVelocity;
-		glm::vec3 &linearVelocityB = m_velocities[indexB].linearVelocity;
-		glm::vec3 &angularVelocityA = m_velocities[indexA].angularVelocity;
-		glm::vec3 &angularVelocityB = m_velocities[indexB].angularVelocity;
+		for (int32_t j = 0; j < velocityConstraint.pointCount; ++j)
+		{
+			ManifoldPoint &manifoldPoint = velocityConstraint.points[j];
+
+			glm::vec3 rA = manifoldPoint.pointA - velocityConstraint.worldCenterA;
+			glm::vec3 rB = manifoldPoint.pointB - velocityConstraint.worldCenterB;
+			glm::vec3 relativeVelocity = velocityB.linearVelocity + glm::cross(velocityB.angularVelocity, rB) -
+										 velocityA.linearVelocity - glm::cross(velocityA.angularVelocity, rA);
+			float normalSpeed = glm::dot(relativeVelocity, manifoldPoint.normal);
+
+			manifoldPoint.velocityBias = 0.0f;
+			if (normalSpeed < -RESTITUTION_VELOCITY)
+			{
+				manifoldPoint.velocityBias = -velocityConstraint.restitution * normalSpeed;
+			}
+		}
+	}
+}
 
-		// std::cout << "\n\nbefore velocity!!!\n";
-		// std::cout << "linear velocityA: " << linearVelocityA.x << " " << linearVelocityA.y << " " << linearVelocityA.z << "\n";
-		// std::cout << "linear velocityB: " << linearVelocityB.x << " " << linearVelocityB.y << " " << linearVelocityB.z << "\n";
-		// std::cout << "angular velocityA: " << angularVelocityA.x << " " << angularVelocityA.y << " " << angularVelocityA.z << "\n";
-		// std::cout << "angular velocityB: " << angularVelocityB.x << " " << angularVelocityB.y << " " << angularVelocityB.z << "\n";
+// 이전 step에서 재사용한 누적 충격량을 반복 전에 미리 적용
+void ContactSolver::warmStart()
+{
+	for (int32_t i = 0; i < m_contactCount; i++)
+	{
+		warmStartConstraint(i);
+	}
+}
 
-		glm::vec3 &linearVelocityBufferA = m_velocities[indexA].linearVelocityBuffer;
-		glm::vec3 &linearVelocityBufferB = m_velocities[indexB].linearVelocityBuffer;
-		glm::vec3 &angularVelocityBufferA = m_velocities[indexA].angularVelocityBuffer;
-		glm::vec3 &angularVelocityBufferB = m_velocities[indexB].angularVelocityBuffer;
+void ContactSolver::warmStart(TaskScheduler &scheduler)
+{
+	solveColors(scheduler, [this](int32_t i) { warmStartConstraint(i); });
+}
 
-		bool isStop = true;
+void ContactSolver::warmStartConstraint(int32_t i)
+{
+	ContactVelocityConstraint &velocityConstraint = m_velocityConstraints[i];
+	Velocity &velocityA = m_velocities[velocityConstraint.indexA];
+	Velocity &velocityB = m_velocities[velocityConstraint.indexB];
 
-		float seperationSum = 0.0f;
+	glm::vec3 linearVelocityBufferA(0.0f);
+	glm::vec3 linearVelocityBufferB(0.0f);
+	glm::vec3 angularVelocityBufferA(0.0f);
+	glm::vec3 angularVelocityBufferB(0.0f);
 
-		for (int32_t j = 0; j < pointCount; ++j)
+	for (int32_t j = 0; j < velocityConstraint.pointCount; ++j)
+	{
+		ManifoldPoint &manifoldPoint = velocityConstraint.points[j];
+
+		glm::vec3 rA = manifoldPoint.pointA - velocityConstraint.worldCenterA;
+		glm::vec3 rB = manifoldPoint.pointB - velocityConstraint.worldCenterB;
+
+		// 법선 충격량의 방향이 바뀌었을 수 있으므로 접선 충격량은 현재 접촉면에 투영
+		glm::vec3 tangentImpulse = manifoldPoint.tangentImpulse -
+								   glm::dot(manifoldPoint.tangentImpulse, manifoldPoint.normal) * manifoldPoint.normal;
+		glm::vec3 impulse = manifoldPoint.normalImpulse * manifoldPoint.normal + tangentImpulse;
+
+		linearVelocityBufferA -= velocityConstraint.invMassA * impulse;
+		linearVelocityBufferB += velocityConstraint.invMassB * impulse;
+		angularVelocityBufferA -= velocityConstraint.invIA * glm::cross(rA, impulse);
+		angularVelocityBufferB += velocityConstraint.invIB * glm::cross(rB, impulse);
+	}
+
+	if (velocityConstraint.invMassA != 0.0f)
+	{
+		velocityA.linearVelocity += linearVelocityBufferA;
+		velocityA.angularVelocity += angularVelocityBufferA;
+	}
+	if (velocityConstraint.invMassB != 0.0f)
+	{
+		velocityB.linearVelocity += linearVelocityBufferB;
+		velocityB.angularVelocity += angularVelocityBufferB;
+	}
+}
+
+void ContactSolver::solveVelocityConstraints()
+{
+	for (int32_t i = 0; i < m_contactCount; i++)
+	{
+		solveVelocityConstraint(i);
+	}
+
+	// for (int32_t i = 0; i < m_bodyCount; ++i)
+	// {
+		
+		// std::cout << "\n\nafter velocity!!!\n";
+		// std::cout << "linear velocity: " << m_velocities[i].linearVelocity.x << " " << m_velocities[i].linearVelocity.y << " " << m_velocities[i].linearVelocity.z << "\n";
+		// std::cout << "angular velocity: " << m_velocities[i].angularVelocity.x << " " << m_velocities[i].angularVelocity.y << " " << m_velocities[i].angularVelocity.z << "\n";
+	// }
+}
+
+void ContactSolver::solveVelocityConstraint(int32_t i)
+{
+	Contact *contact = m_contacts[i];
+	ContactVelocityConstraint &velocityConstraint = m_velocityConstraints[i];
+	int32_t pointCount = velocityConstraint.pointCount;
+	int32_t indexA = velocityConstraint.indexA;
+	int32_t indexB = velocityConstraint.indexB;
+
+	glm::vec3 &linearVelocityA = m_velocities[indexA].linearVelocity;
+	glm::vec3 &linearVelocityB = m_velocities[indexB].linearVelocity;
+	glm::vec3 &angularVelocityA = m_velocities[indexA].angularVelocity;
+	glm::vec3 &angularVelocityB = m_velocities[indexB].angularVelocity;
+
+	// std::cout << "\n\nbefore velocity!!!\n";
+	// std::cout << "linear velocityA: " << linearVelocityA.x << " " << linearVelocityA.y << " " << linearVelocityA.z << "\n";
+	// std::cout << "linear velocityB: " << linearVelocityB.x << " " << linearVelocityB.y << " " << linearVelocityB.z << "\n";
+	// std::cout << "angular velocityA: " << angularVelocityA.x << " " << angularVelocityA.y << " " << angularVelocityA.z << "\n";
+	// std::cout << "angular velocityB: " << angularVelocityB.x << " " << angularVelocityB.y << " " << angularVelocityB.z << "\n";
+
+	// 같은 color의 contact들이 동시에 풀릴 수 있으므로 변화량은 지역 변수에 모았다가 마지막에 반영
+	glm::vec3 linearVelocityBufferA(0.0f);
+	glm::vec3 linearVelocityBufferB(0.0f);
+	glm::vec3 angularVelocityBufferA(0.0f);
+	glm::vec3 angularVelocityBufferB(0.0f);
+
+	bool isStop = true;
+
+	float seperationSum = 0.0f;
+
+	for (int32_t j = 0; j < pointCount; ++j)
+	{
+		seperationSum += velocityConstraint.points[j].seperation;
+	}
+
+	if (seperationSum <= 0.0f)
+	{
+		return;
+	}
+
+	for (int32_t j = 0; j < pointCount; ++j)
+	{
+		ManifoldPoint &manifoldPoint = velocityConstraint.points[j];
+		
+		glm::vec3 rA = manifoldPoint.pointA - velocityConstraint.worldCenterA; // bodyA의 충돌 지점까지의 벡터
+		glm::vec3 rB = manifoldPoint.pointB - velocityConstraint.worldCenterB; // bodyB의 충돌 지점까지의 벡터
+
+		// 상대 속도 계산
+		glm::vec3 velocityA = linearVelocityA + glm::cross(angularVelocityA, rA);
+		glm::vec3 velocityB = linearVelocityB + glm::cross(angularVelocityB, rB);
+		glm::vec3 relativeVelocity = velocityB - velocityA;
+
+		// 법선 방향 속도
+		float normalSpeed = glm::dot(relativeVelocity, manifoldPoint.normal);
+		float inverseMasses = (velocityConstraint.invMassA + velocityConstraint.invMassB);
+		float seperationRatio = manifoldPoint.seperation / seperationSum;
+
+		if (glm::length2(rA) == 0.0f)
 		{
-			seperationSum += velocityConstraint.points[j].seperation;
+			throw std::runtime_error("normal rA is zero!!");
 		}
 
-		if (seperationSum <= 0.0f)
+		if (glm::length2(rB) == 0.0f)
 		{
-			continue ;
+			throw std::runtime_error("normal rB is zero!!");
 		}
 
-		for (int32_t j = 0; j < pointCount; ++j)
+		// 누적 충격량이 음수가 되지 않는 범위에서 적용 (warm start로 과하게 밀어낸 만큼은 되돌림)
+		float oldNormalImpulse = manifoldPoint.normalImpulse;
+		if (normalSpeed - manifoldPoint.velocityBias < -NORMAL_STOP_VELOCITY || oldNormalImpulse > 0.0f)
 		{
-			ManifoldPoint &manifoldPoint = velocityConstraint.points[j];
-			
-			glm::vec3 rA = manifoldPoint.pointA - velocityConstraint.worldCenterA; // bodyA의 충돌 지점까지의 벡터
-			glm::vec3 rB = manifoldPoint.pointB - velocityConstraint.worldCenterB; // bodyB의 충돌 지점까지의 벡터
+			// std::cout << "normal in!!\n";
+			float normalEffectiveMassA = glm::dot(glm::cross(manifoldPoint.normal, rA),
+												  velocityConstraint.invIA * glm::cross(manifoldPoint.normal, rA));
+			float normalEffectiveMassB = glm::dot(glm::cross(manifoldPoint.normal, rB),
+												  velocityConstraint.invIB * glm::cross(manifoldPoint.normal, rB));
 
-			// 상대 속도 계산
-			glm::vec3 velocityA = linearVelocityA + glm::cross(angularVelocityA, rA);
-			glm::vec3 velocityB = linearVelocityB + glm::cross(angularVelocityB, rB);
-			glm::vec3 relativeVelocity = velocityB - velocityA;
+			float normalImpulse = -(normalSpeed - manifoldPoint.velocityBias) * seperationRatio;
+			normalImpulse = normalImpulse / (inverseMasses + normalEffectiveMassA + normalEffectiveMassB);
 
-			// 법선 방향 속도
+			float newNormalImpulse = std::max(oldNormalImpulse + normalImpulse, 0.0f);
+			manifoldPoint.normalImpulse = newNormalImpulse;
 
-			float normalSpeed = glm::dot(relativeVelocity, manifoldPoint.normal);
-			float appliedNormalImpulse;
+			float appliedNormalImpulse = newNormalImpulse - oldNormalImpulse;
+			glm::vec3 impulse = appliedNormalImpulse * manifoldPoint.normal;
 
-			if (normalSpeed < -NORMAL_STOP_VELOCITY)
-			{
-				// std::cout << "normal in!!\n";
-
-				float oldNormalImpulse = manifoldPoint.normalImpulse;
-				appliedNormalImpulse = -(1.0f + velocityConstraint.restitution) * normalSpeed * (manifoldPoint.seperation / seperationSum);
-				float inverseMasses = (velocityConstraint.invMassA + velocityConstraint.invMassB);
-				float normalEffectiveMassA = glm::dot(glm::cross(manifoldPoint.normal, rA),
-													  velocityConstraint.invIA * glm::cross(manifoldPoint.normal, rA));
-				float normalEffectiveMassB = glm::dot(glm::cross(manifoldPoint.normal, rB),
-													  velocityConstraint.invIB * glm::cross(manifoldPoint.normal, rB));
-
-				appliedNormalImpulse =
-					appliedNormalImpulse / (inverseMasses + normalEffectiveMassA + normalEffectiveMassB);
-
-				float newNormalImpulse = appliedNormalImpulse + oldNormalImpulse;
-
-				manifoldPoint.normalImpulse = newNormalImpulse;
-
-				if (manifoldPoint.normalImpulse <= 0.0f)
-				{
-					manifoldPoint.normalImpulse = 0.0f;
-				}
-
-				// if (appliedNormalImpulse > 400.0f || appliedNormalImpulse < 0.0f)
-				{
-					// std::cout << "normalSpeed: " << normalSpeed << "\n"; 
-					// std::cout << "normalImpusle: " << appliedNormalImpulse << "\n";
-				}
-
-				linearVelocityBufferA -= velocityConstraint.invMassA * appliedNormalImpulse * manifoldPoint.normal;
-				linearVelocityBufferB += velocityConstraint.invMassB * appliedNormalImpulse * manifoldPoint.normal;
-
-				if (glm::length2(rA) == 0.0f)
-				{
-					throw std::runtime_error("normal rA is zero!!");
-				}
-
-				if (glm::length2(rB) == 0.0f)
-				{
-					throw std::runtime_error("normal rB is zero!!");
-				}
-
-				// if (glm::length2(rA) != 0.0f)
-				{
-					angularVelocityBufferA -=
-						velocityConstraint.invIA * glm::cross(rA, appliedNormalImpulse * manifoldPoint.normal);
-				}
-				// if (glm::length2(rB) != 0.0f)
-				{
-					angularVelocityBufferB +=
-						velocityConstraint.invIB * glm::cross(rB, appliedNormalImpulse * manifoldPoint.normal);
-				}
-
-				// std::cout << "\n\nAAAA\n";
-				
-				// std::cout << "before: " << glm::cross(rA, appliedNormalImpulse * manifoldPoint.normal).x << " "
-				// 		  << glm::cross(rA, appliedNormalImpulse * manifoldPoint.normal).y << " "
-				// 		  << glm::cross(rA, appliedNormalImpulse * manifoldPoint.normal).z << "\n";
-						  
-				// std::cout << "after: " << (velocityConstraint.invIA * glm::cross(rA, appliedNormalImpulse * manifoldPoint.normal)).x << " "
-				// 		  << (velocityConstraint.invIA * glm::cross(rA, appliedNormalImpulse * manifoldPoint.normal)).y << " "
-				// 		  << (velocityConstraint.invIA * glm::cross(rA, appliedNormalImpulse * manifoldPoint.normal)).z << "\n";
-				
-				// std::cout << "\n\nBBB\n";
-				// std::cout << "before: " << glm::cross(rB, appliedNormalImpulse * manifoldPoint.normal).x << " "
-				// 		  << glm::cross(rB, appliedNormalImpulse * manifoldPoint.normal).y << " "
-				// 		  << glm::cross(rB, appliedNormalImpulse * manifoldPoint.normal).z << "\n";
-						  
-				// std::cout << "after: " << (velocityConstraint.invIB * glm::cross(rB, appliedNormalImpulse * manifoldPoint.normal)).x << " "
-				// 		  << (velocityConstraint.invIB * glm::cross(rB, appliedNormalImpulse * manifoldPoint.normal)).y << " "
-				// 		  << (velocityConstraint.invIB * glm::cross(rB, appliedNormalImpulse * manifoldPoint.normal)).z << "\n";
-			}
+			linearVelocityBufferA -= velocityConstraint.invMassA * impulse;
+			linearVelocityBufferB += velocityConstraint.invMassB * impulse;
+			angularVelocityBufferA -= velocityConstraint.invIA * glm::cross(rA, impulse);
+			angularVelocityBufferB += velocityConstraint.invIB * glm::cross(rB, impulse);
+		}
 
-			// 접선 방향 충격량 계산
-			glm::vec3 tangentVelocity = relativeVelocity - (normalSpeed * manifoldPoint.normal);
-			glm::vec3 tangent = glm::normalize(tangentVelocity);
-			float tangentSpeed = glm::dot(tangent, tangentVelocity);
+		// 접선 방향 충격량 계산
+		// 누적 충격량은 접촉면 위의 vector로 관리하고 크기를 마찰 한계로 제한
+		glm::vec3 tangentVelocity = relativeVelocity - (normalSpeed * manifoldPoint.normal);
+		float tangentSpeed = glm::length(tangentVelocity);
 
-			if (tangentSpeed > TANGENT_STOP_VELOCITY)
-			{
-				// std::cout << "tangent in!!\n";
+		glm::vec3 oldTangentImpulse = manifoldPoint.tangentImpulse;
+		glm::vec3 newTangentImpulse =
+			oldTangentImpulse - glm::dot(oldTangentImpulse, manifoldPoint.normal) * manifoldPoint.normal;
 
-				// std::cout << "releativeVelocity: " << relativeVelocity.x << " " << relativeVelocity.y << " " << relativeVelocity.z << "\n";
-				// std::cout << "tangentVelocity: " << tangentVelocity.x << " " << tangentVelocity.y << " " << tangentVelocity.z << "\n";
-				// std::cout << "tangentSpeed: " << tangentSpeed << "\n";
-				float oldTangentImpulse = manifoldPoint.tangentImpulse;
-				float newTangentImpulse = tangentSpeed * (manifoldPoint.seperation / seperationSum);
+		if (tangentSpeed > TANGENT_STOP_VELOCITY)
+		{
+			// std::cout << "tangent in!!\n";
+			glm::vec3 tangent = tangentVelocity / tangentSpeed;
 
-				float inverseMasses = (velocityConstraint.invMassA + velocityConstraint.invMassB);
-		
-				float tangentEffectiveMassA =
-					glm::dot(glm::cross(tangent, rA), velocityConstraint.invIA * glm::cross(tangent, rA));
-				float tangentEffectiveMassB =
-					glm::dot(glm::cross(tangent, rB), velocityConstraint.invIB * glm::cross(tangent, rB));
-				newTangentImpulse = newTangentImpulse / (inverseMasses + tangentEffectiveMassA + tangentEffectiveMassB);
-				newTangentImpulse += oldTangentImpulse;
-
-				float maxFriction = velocityConstraint.friction * manifoldPoint.normalImpulse;
-				// std::cout << "maxFriction: " << maxFriction << "\n";
-				// std::cout << "newTangentImpulse: " << newTangentImpulse << "\n";
-				newTangentImpulse = glm::clamp(newTangentImpulse, -maxFriction, maxFriction);
-
-				manifoldPoint.tangentImpulse = newTangentImpulse;
-
-				float appliedTangentImpulse = newTangentImpulse - oldTangentImpulse;
-				
-				// if (appliedTangentImpulse > 100.0f)
-				// {
-				// 	std::cout << "\n\ntangent: " << tangent.x << " " << tangent.y << " " << tangent.z << "\n";
-				// 	std::cout << "appliedTangnentImpulse: " << appliedTangentImpulse << "\n";
-				// }
-
-				linearVelocityBufferA += velocityConstraint.invMassA * appliedTangentImpulse * tangent;
-				linearVelocityBufferB -= velocityConstraint.invMassB * appliedTangentImpulse * tangent;
-
-				if (glm::length2(rA) == 0.0f)
-				{
-					throw std::runtime_error("tangent rA is zero!!");
-				}
-
-				if (glm::length2(rB) == 0.0f)
-				{
-					throw std::runtime_error("tangent rB is zero!!");
-				}
-
-				
-				if (glm::length2(tangent) == 0.0f)
-				{
-					throw std::runtime_error("tangent vector is zero!!");
-				}
-
-				// if (glm::length2(rA) != 0.0f)
-				{
-					angularVelocityBufferA +=
-						velocityConstraint.invIA * glm::cross(rA, appliedTangentImpulse * tangent);
-				}
-
-				// if (glm::length2(rB) != 0.0f)
-				{
-					angularVelocityBufferB -=
-						velocityConstraint.invIB * glm::cross(rB, appliedTangentImpulse * tangent);
-				}
-				
-				// std::cout << "\n\nAAAA\n";
-				// std::cout << "before: " << glm::cross(rA, appliedTangentImpulse * tangent).x << " "
-				// 		<< glm::cross(rA, appliedTangentImpulse * tangent).y << " "
-				// 		<< glm::cross(rA, appliedTangentImpulse * tangent).z << "\n";
-						
-				// std::cout << "after: " << (velocityConstraint.invIA * glm::cross(rA, appliedTangentImpulse * tangent)).x << " "
-				// 		<< (velocityConstraint.invIA * glm::cross(rA, appliedTangentImpulse * tangent)).y << " "
-				// 		<< (velocityConstraint.invIA * glm::cross(rA, appliedTangentImpulse * tangent)).z << "\n";
-				
-				// std::cout << "\n\nBBB\n";
-				// std::cout << "before: " << glm::cross(rB, appliedTangentImpulse * tangent).x << " "
-				// 		<< glm::cross(rB, appliedTangentImpulse * tangent).y << " "
-				// 		<< glm::cross(rB, appliedTangentImpulse * tangent).z << "\n";
-						
-				// std::cout << "after: " << (velocityConstraint.invIB * glm::cross(rB, appliedTangentImpulse * tangent)).x << " "
-				// 		<< (velocityConstraint.invIB * glm::cross(rB, appliedTangentImpulse * tangent)).y << " "
-				// 		<< (velocityConstraint.invIB * glm::cross(rB, appliedTangentImpulse * tangent)).z << "\n";
-			}
+			float tangentEffectiveMassA =
+				glm::dot(glm::cross(tangent, rA), velocityConstraint.invIA * glm::cross(tangent, rA));
+			float tangentEffectiveMassB =
+				glm::dot(glm::cross(tangent, rB), velocityConstraint.invIB * glm::cross(tangent, rB));
+
+			float tangentImpulse = tangentSpeed * seperationRatio;
+			tangentImpulse = tangentImpulse / (inverseMasses + tangentEffectiveMassA + tangentEffectiveMassB);
+			newTangentImpulse -= tangentImpulse * tangent;
+		}
 
-			// glm::vec3 relativeAngularVelocity = angularVelocityB - angularVelocityA;
+		float maxFriction = velocityConstraint.friction * manifoldPoint.normalImpulse;
+		float tangentImpulseLength = glm::length(newTangentImpulse);
+		if (tangentImpulseLength > maxFriction)
+		{
+			newTangentImpulse *= maxFriction / tangentImpulseLength;
+		}
 
-			// if (glm::length(relativeAngularVelocity) > 0.0001f)
-			// {
+		manifoldPoint.tangentImpulse = newTangentImpulse;
 
-			// 	// 회전 축 벡터 (법선 방향에 평행)
-			// 	glm::vec3 rotationalAxis = glm::normalize(relativeAngularVelocity); // 상대 각속도의 방향
+		glm::vec3 appliedTangentImpulse = newTangentImpulse - oldTangentImpulse;
+		linearVelocityBufferA -= velocityConstraint.invMassA * appliedTangentImpulse;
+		linearVelocityBufferB += velocityConstraint.invMassB * appliedTangentImpulse;
+		angularVelocityBufferA -= velocityConstraint.invIA * glm::cross(rA, appliedTangentImpulse);
+		angularVelocityBufferB += velocityConstraint.invIB * glm::cross(rB, appliedTangentImpulse);
 
-			// 	// 유효 관성 계산
-			// 	float rotationalEffectiveMassA = glm::dot(rotationalAxis, velocityConstraint.invIA * rotationalAxis);
-			// 	float rotationalEffectiveMassB = glm::dot(rotationalAxis, velocityConstraint.invIB * rotationalAxis);
-			// 	float rotationalEffectiveMass = 1.0f / (rotationalEffectiveMassA + rotationalEffectiveMassB);
+		// glm::vec3 relativeAngularVelocity = angularVelocityB - angularVelocityA;
 
-			// 	// 회전 마찰 토크 계산
-			// 	glm::vec3 rotationalFrictionTorque = -rotationalEffectiveMass * relativeAngularVelocity * (manifoldPoint.seperation / seperationSum);
+		// if (glm::length(relativeAngularVelocity) > 0.0001f)
+		// {
 
-			// 	// 최대 회전 마찰 제한
-			// 	float maxRotationalFriction = velocityConstraint.friction * manifoldPoint.normalImpulse;
-			// 	float torqueMagnitude = glm::length(rotationalFrictionTorque);
-			// 	if (torqueMagnitude > maxRotationalFriction)
-			// 	{
-			// 		rotationalFrictionTorque *= (maxRotationalFriction / torqueMagnitude);
-			// 	}
+		// 	// 회전 축 벡터 (법선 방향에 평행)
+		// 	glm::vec3 rotationalAxis = glm::normalize(relativeAngularVelocity); // 상대 각속도의 방향
 
-			// 	// 각속도 업데이트
-			// 	angularVelocityBufferA -= velocityConstraint.invIA * rotationalFrictionTorque;
-			// 	angularVelocityBufferB += velocityConstraint.invIB * rotationalFrictionTorque;
-			// }
+		// 	// 유효 관성 계산
+		// 	float rotationalEffectiveMassA = glm::dot(rotationalAxis, velocityConstraint.invIA * rotationalAxis);
+		// 	float rotationalEffectiveMassB = glm::dot(rotationalAxis, velocityConstraint.invIB * rotationalAxis);
+		// 	float rotationalEffectiveMass = 1.0f / (rotationalEffectiveMassA + rotationalEffectiveMassB);
 
-		}
+		// 	// 회전 마찰 토크 계산
+		// 	glm::vec3 rotationalFrictionTorque = -rotationalEffectiveMass * relativeAngularVelocity * (manifoldPoint.seperation / seperationSum);
+
+		// 	// 최대 회전 마찰 제한
+		// 	float maxRotationalFriction = velocityConstraint.friction * manifoldPoint.normalImpulse;
+		// 	float torqueMagnitude = glm::length(rotationalFrictionTorque);
+		// 	if (torqueMagnitude > maxRotationalFriction)
+		// 	{
+		// 		rotationalFrictionTorque *= (maxRotationalFriction / torqueMagnitude);
+		// 	}
+
+		// 	// 각속도 업데이트
+		// 	angularVelocityBufferA -= velocityConstraint.invIA * rotationalFrictionTorque;
+		// 	angularVelocityBufferB += velocityConstraint.invIB * rotationalFrictionTorque;
+		// }
+
+	}
+
+	// static body는 여러 contact가 공유하므로 쓰지 않음 (질량, 관성이 0이라 변화량도 0)
+	if (velocityConstraint.invMassA != 0.0f)
+	{
 		linearVelocityA += linearVelocityBufferA;
-		linearVelocityB += linearVelocityBufferB;
 		angularVelocityA += angularVelocityBufferA;
+	}
+	if (velocityConstraint.invMassB != 0.0f)
+	{
+		linearVelocityB += linearVelocityBufferB;
 		angularVelocityB += angularVelocityBufferB;
-		linearVelocityBufferA = glm::vec3(0.0f);
-		linearVelocityBufferB = glm::vec3(0.0f);
-		angularVelocityBufferA = glm::vec3(0.0f);
-		angularVelocityBufferB = glm::vec3(0.0f);
 	}
-
-	// for (int32_t i = 0; i < m_bodyCount; ++i)
-	// {
-		
-		// std::cout << "\n\nafter velocity!!!\n";
-		// std::cout << "linear velocity: " << m_velocities[i].linearVelocity.x << " " << m_velocities[i].linearVelocity.y << " " << m_velocities[i].linearVelocity.z << "\n";
-		// std::cout << "angular velocity: " << m_velocities[i].angularVelocity.x << " " << m_velocities[i].angularVelocity.y << " " << m_velocities[i].angularVelocity.z << "\n";
-	// }
 }
 
 void ContactSolver::solvePositionConstraints()
+{
+	for (int32_t i = 0; i < m_contactCount; ++i)
+	{
+		solvePositionConstraint(i);
+	}
+}
+
+void ContactSolver::solvePositionConstraint(int32_t i)
 {
 	const float kSlop = 0.001f; // 허용 관통 오차
 	const float alpha = 1.0f;
 
-	for (int i = 0; i < m_contactCount; ++i)
+	Contact *contact = m_contacts[i];
+	ContactPositionConstraint &positionConstraint = m_positionConstraints[i];
+
+	int32_t pointCount = positionConstraint.pointCount;
+	int32_t indexA = positionConstraint.indexA;
+	int32_t indexB = positionConstraint.indexB;
+
+	glm::mat3 &invIA = positionConstraint.invIA;
+	glm::mat3 &invIB = positionConstraint.invIB;
+
+	float sumMass = positionConstraint.invMassA + positionConstraint.invMassB;
+	float ratioA = positionConstraint.invMassA / sumMass;
+	float ratioB = positionConstraint.invMassB / sumMass;
+
+	glm::vec3 &positionBufferA = m_positions[indexA].positionBuffer;
+	glm::vec3 &positionBufferB = m_positions[indexB].positionBuffer;
+
+	for (int32_t j = 0; j < pointCount; j++)
 	{
-		Contact *contact = m_contacts[i];
-		ContactPositionConstraint &positionConstraint = m_positionConstraints[i];
 
-		int32_t pointCount = positionConstraint.pointCount;
-		int32_t indexA = positionConstraint.indexA;
-		int32_t indexB = positionConstraint.indexB;
+		ManifoldPoint &manifoldPoint = positionConstraint.points[j];
 
-		glm::mat3 &invIA = positionConstraint.invIA;
-		glm::mat3 &invIB = positionConstraint.invIB;
+		glm::vec3 movedPointA = manifoldPoint.pointA + positionBufferA;
+		glm::vec3 movedPointB = manifoldPoint.pointB + positionBufferB;
 
-		float sumMass = positionConstraint.invMassA + positionConstraint.invMassB;
-		float ratioA = positionConstraint.invMassA / sumMass;
-		float ratioB = positionConstraint.invMassB / sumMass;
+		float seperation = glm::dot(manifoldPoint.normal, movedPointA - movedPointB);
 
-		glm::vec3 &positionBufferA = m_positions[indexA].positionBuffer;
-		glm::vec3 &positionBufferB = m_positions[indexB].positionBuffer;
+		// 관통 해소된상태면 무시
+		if (seperation < kSlop)
+		{
+			continue;
+		}
+
+		// 관통 깊이에 따른 보정량 계산
+		float correction = seperation * alpha / pointCount;
+		glm::vec3 correctionVector = correction * manifoldPoint.normal;
 
-		for (int32_t j = 0; j < pointCount; j++)
+		// static body의 positionBuffer는 항상 0이므로 쓰지 않음
+		if (positionConstraint.invMassA != 0.0f)
+		{
+			positionBufferA -= correctionVector * ratioA;
+		}
+		if (positionConstraint.invMassB != 0.0f)
 		{
+			positionBufferB += correctionVector * ratioB;
+		}
+	}
+}
 
-			ManifoldPoint &manifoldPoint = positionConstraint.points[j];
+void ContactSolver::colorConstraints()
+{
+	m_colorContacts = static_cast<int32_t *>(m_allocator.allocateStack(sizeof(int32_t) * m_contactCount));
+	int32_t *contactColors = static_cast<int32_t *>(m_allocator.allocateStack(sizeof(int32_t) * m_contactCount));
+	uint64_t *bodyColors = static_cast<uint64_t *>(m_allocator.allocateStack(sizeof(uint64_t) * m_bodyCount));
+	memset(bodyColors, 0, sizeof(uint64_t) * m_bodyCount);
+
+	int32_t colorCounts[MAX_COLOR_COUNT + 1] = {};
 
-			glm::vec3 movedPointA = manifoldPoint.pointA + positionBufferA;
-			glm::vec3 movedPointB = manifoldPoint.pointB + positionBufferB;
+	// greedy coloring - 양쪽 dynamic body 모두 아직 쓰지 않은 가장 작은 color 선택
+	// static body는 solve 중 값이 바뀌지 않으므로 공유해도 됨
+	for (int32_t i = 0; i < m_contactCount; ++i)
+	{
+		ContactVelocityConstraint &velocityConstraint = m_velocityConstraints[i];
+		bool isDynamicA = velocityConstraint.invMassA != 0.0f;
+		bool isDynamicB = velocityConstraint.invMassB != 0.0f;
 
-			float seperation = glm::dot(manifoldPoint.normal, movedPointA - movedPointB);
+		uint64_t usedColors = 0;
+		if (isDynamicA)
+		{
+			usedColors |= bodyColors[velocityConstraint.indexA];
+		}
+		if (isDynamicB)
+		{
+			usedColors |= bodyColors[velocityConstraint.indexB];
+		}
+
+		int32_t color = 0;
+		while (color < MAX_COLOR_COUNT && (usedColors & (uint64_t(1) << color)) != 0)
+		{
+			++color;
+		}
 
-			// 관통 해소된상태면 무시
-			if (seperation < kSlop)
+		if (color < MAX_COLOR_COUNT)
+		{
+			if (isDynamicA)
+			{
+				bodyColors[velocityConstraint.indexA] |= uint64_t(1) << color;
+			}
+			if (isDynamicB)
 			{
-				continue;
+				bodyColors[velocityConstraint.indexB] |= uint64_t(1) << color;
 			}
+		}
+
+		contactColors[i] = color;
+		++colorCounts[color];
+	}
 
-			// 관통 깊이에 따른 보정량 계산
-			float correction = seperation * alpha / pointCount;
-			glm::vec3 correctionVector = correction * manifoldPoint.normal;
+	// color 순서대로 contact index 정렬 (같은 color 안에서는 원래 순서 유지)
+	m_colorOffsets[0] = 0;
+	for (int32_t color = 0; color <= MAX_COLOR_COUNT; ++color)
+	{
+		m_colorOffsets[color + 1] = m_colorOffsets[color] + colorCounts[color];
+		colorCounts[color] = m_colorOffsets[color];
+	}
 
-			positionBufferA -= correctionVector * ratioA;
-			positionBufferB += correctionVector * ratioB;
+	for (int32_t i = 0; i < m_contactCount; ++i)
+	{
+		m_colorContacts[colorCounts[contactColors[i]]++] = i;
+	}
+
+	m_allocator.freeStack();
+	m_allocator.freeStack();
+}
+
+template <typename F> void ContactSolver::solveColors(TaskScheduler &scheduler, F solveConstraint)
+{
+	for (int32_t color = 0; color <= MAX_COLOR_COUNT; ++color)
+	{
+		int32_t begin = m_colorOffsets[color];
+		int32_t end = m_colorOffsets[color + 1];
+		int32_t count = end - begin;
+
+		// overflow color는 body를 공유할 수 있고, 작은 color는 스레드에 나누는 비용이 더 큼
+		if (color == OVERFLOW_COLOR || count < MIN_PARALLEL_COLOR_SIZE)
+		{
+			for (int32_t i = begin; i < end; ++i)
+			{
+				solveConstraint(m_colorContacts[i]);
+			}
+			continue;
 		}
+
+		int32_t chunkCount = (count + COLOR_CHUNK_SIZE - 1) / COLOR_CHUNK_SIZE;
+		scheduler.parallelFor(chunkCount, [this, begin, end, &solveConstraint](int32_t index, int32_t) {
+			int32_t chunkBegin = begin + index * COLOR_CHUNK_SIZE;
+			int32_t chunkEnd = std::min(chunkBegin + COLOR_CHUNK_SIZE, end);
+			for (int32_t i = chunkBegin; i < chunkEnd; ++i)
+			{
+				solveConstraint(m_colorContacts[i]);
+			}
+		});
 	}
 }
 
+void ContactSolver::solveVelocityConstraints(TaskScheduler &scheduler)
+{
+	solveColors(scheduler, [this](int32_t i) { solveVelocityConstraint(i); });
+}
+
+void ContactSolver::solvePositionConstraints(TaskScheduler &scheduler)
+{
+	solveColors(scheduler, [this](int32_t i) { solvePositionConstraint(i); });
+}
+
 void ContactSolver::checkSleepContact()
 {
 
@@ -21,39 +21,23 @@ int32_t CylinderShape::getChildCount() const
 	return 1;
 }
 
+// 축 방향 선분 + 축에 수직인 원판의 world 축 방향 반지름 (r * sqrt(1 - axis_i^2))
 void CylinderShape::computeAABB(AABB *aabb, const Transform &xf) const
 {
-	// update vertices
-	std::vector<glm::vec3> vertexVector(m_vertices.begin(), m_vertices.end());
-	glm::mat4 transformMatrix = xf.toMatrix();
+	glm::quat orientation = glm::normalize(xf.orientation);
+	glm::vec3 center = xf.position + orientation * m_center;
+	glm::vec3 axis = orientation * m_axes[0];
+	float halfHeight = m_height * 0.5f;
 
-	glm::vec3 upper(std::numeric_limits<float>::lowest());
-	glm::vec3 lower(std::numeric_limits<float>::max());
-
-	for (glm::vec3 &vertex : vertexVector)
+	glm::vec3 extent;
+	for (int32_t i = 0; i < 3; ++i)
 	{
-		glm::vec4 v = transformMatrix * glm::vec4(vertex, 1.0f);
-		vertex = glm::vec3(v.x, v.y, v.z);
-
-		upper.x = std::max(upper.x, vertex.x);
-		upper.y = std::max(upper.y, vertex.y);
-		upper.z = std::max(upper.z, vertex.z);
-		lower.x = std::min(lower.x, vertex.x);
-		lower.y = std::min(lower.y, vertex.y);
-		lower.z = std::min(lower.z, vertex.z);
+		float discExtent = std::sqrt(std::max(0.0f, 1.0f - axis[i] * axis[i]));
+		extent[i] = std::abs(axis[i]) * halfHeight + m_radius * discExtent;
 	}
 
-	// 최적화 여지 있음.
-	// std::sort(vertexVector.begin(), vertexVector.end(), Vec3Comparator());
-
-	// glm::vec3 upper = *std::prev(vertexVector.end());
-	// glm::vec3 lower = *vertexVector.begin();
-
-	// std::cout << "upper: " << upper.x << ", " << upper.y << ", " << upper.z << '\n';
-	// std::cout << "lower: " << lower.x << ", " << lower.y << ", " << lower.z << '\n';
-
-	aabb->upperBound = upper + glm::vec3(0.1f);
-	aabb->lowerBound = lower - glm::vec3(0.1f);
+	aabb->upperBound = center + extent + glm::vec3(0.1f);
+	aabb->lowerBound = center - extent - glm::vec3(0.1f);
 }
 
 // void CylinderShape::findAxisByLongestPair(const std::vector<Vertex> &vertices)
@@ -97,33 +81,35 @@ void CylinderShape::computeAABB(AABB *aabb, const Transform &xf) const
 // 	m_axis[0] = axis;
 // }
 
-void CylinderShape::computeCylinderFeatures(const std::vector<Vertex> &vertices)
+void CylinderShape::computeCylinderFeatures(const std::vector<glm::vec3> &positions)
 {
 	glm::vec3 min(FLT_MAX);
 	glm::vec3 max(-FLT_MAX);
 
-	for (const Vertex &vertex : vertices)
+	for (const glm::vec3 &position : positions)
 	{
-		max.x = std::max(vertex.position.x, max.x);
-		max.y = std::max(vertex.position.y, max.y);
-		max.z = std::max(vertex.position.z, max.z);
+		max.x = std::max(position.x, max.x);
+		max.y = std::max(position.y, max.y);
+		max.z = std::max(position.z, max.z);
 
-		min.x = std::min(vertex.position.x, min.x);
-		min.y = std::min(vertex.position.y, min.y);
-		min.z = std::min(vertex.position.z, min.z);
+		min.x = std::min(position.x, min.x);
+		min.y = std::min(position.y, min.y);
+		min.z = std::min(position.z, min.z);
 
-		m_vertices.insert(vertex.position);
+		m_vertices.insert(position);
 	}
 
 	m_center = (min + max) / 2.0f;
 	m_axes[0] = glm::vec3(0.0f, 1.0f, 0.0f);
+	m_axes[1] = glm::vec3(1.0f, 0.0f, 0.0f);
+	m_axes[2] = glm::cross(m_axes[0], m_axes[1]);
 	m_height = max.y - min.y;
 
 	m_radius = 0.0f;
 	glm::vec2 center(m_center.x, m_center.z);
-	for (const Vertex &vertex : vertices)
+	for (const glm::vec3 &position : positions)
 	{
-		m_radius = std::max(m_radius, glm::length2(glm::vec2(vertex.position.x, vertex.position.z) - center));
+		m_radius = std::max(m_radius, glm::length2(glm::vec2(position.x, position.z) - center));
 	}
 	m_radius = std::sqrt(m_radius);
 }
@@ -159,105 +145,31 @@ void CylinderShape::computeCylinderFeatures(const std::vector<Vertex> &vertices)
 // 	m_radius = maxRadius;
 // }
 
-void CylinderShape::createCylinderPoints()
-{
-	int32_t segments = 20;
-	float angleStep = 2.0f * glm::pi<float>() / static_cast<float>(segments);
-	glm::vec3 xAxis(1.0f, 0.0f, 0.0f);
-
-	glm::vec4 topPoint = glm::vec4(m_center + m_height * 0.5f * m_axes[0] + xAxis * m_radius, 1.0f);
-	glm::vec4 bottomPoint = glm::vec4(m_center - m_height * 0.5f * m_axes[0] + xAxis * m_radius, 1.0f);
-
-	glm::quat quat = glm::angleAxis(angleStep / 2.0f, m_axes[0]);
-	glm::mat4 mat = glm::toMat4(glm::normalize(quat));
-	glm::vec3 dir = mat * glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
-
-	int32_t base = 0;
-	for (int32_t i = base; i < segments; i++)
-	{
-		float theta = i * angleStep;
-		glm::quat orientation = glm::angleAxis(theta, m_axes[0]);
-		glm::mat4 rotationMatrix = glm::toMat4(glm::normalize(orientation));
-		m_points[i] = rotationMatrix * topPoint;
-		m_axes[i + 1] = rotationMatrix * glm::vec4(dir, 1.0f);
-	}
-
-	base = segments;
-	for (int32_t i = base; i < segments + base; i++)
-	{
-		float theta = (i - base) * angleStep;
-		glm::quat orientation = glm::angleAxis(theta, m_axes[0]);
-		glm::mat4 rotationMatrix = glm::toMat4(glm::normalize(orientation));
-		m_points[i] = rotationMatrix * bottomPoint;
-	}
-
-	// std::cout << "axes !!\n";
-	// for (int i = 0; i <= segments; i++)
-	// {
-	// 	std::cout << "("<< m_axes[i].x << ", " << m_axes[i].y << ", " << m_axes[i].z << ")\n";
-	// }
-
-	// std::cout << "cylinder points!!\n";
-	// for (int i = 0; i < segments * 2; i++)
-	// {
-	// 	std::cout << "("<< m_points[i].x << ", " << m_points[i].y << ", " << m_points[i].z << ")\n";
-	// }
-}
-
-void CylinderShape::setShapeFeatures(const std::vector<Vertex> &vertices)
+void CylinderShape::setShapeFeatures(const std::vector<glm::vec3> &positions)
 {
-	computeCylinderFeatures(vertices);
-	createCylinderPoints();
+	computeCylinderFeatures(positions);
 	// findAxisByLongestPair(vertices);
 	// computeCylinderRadius(vertices);
 }
 
 ConvexInfo CylinderShape::getShapeInfo(const Transform &transform) const
 {
-	glm::mat4 matrix = transform.toMatrix();
-
 	ConvexInfo cylinder;
+	cylinder.shape = this;
+	cylinder.position = transform.position;
+	cylinder.orientation = glm::normalize(transform.orientation);
 	cylinder.radius = m_radius;
 	cylinder.height = m_height;
-	cylinder.center = matrix * glm::vec4(m_center, 1.0f);
-
-	int32_t segments = 20;
+	cylinder.center = cylinder.position + cylinder.orientation * m_center;
 
-	int32_t axesSize = segments + 1;
-	cylinder.axesCount = axesSize;
-	void *memory = PhysicsAllocator::m_blockAllocator.allocateBlock(sizeof(glm::vec3) * cylinder.axesCount);
-	cylinder.axes = static_cast<glm::vec3 *>(memory);
-
-	cylinder.axes[0] = glm::normalize(matrix * glm::vec4(m_axes[0], 0.0f));
-	for (int32_t i = 1; i < axesSize; ++i)
-	{
-		cylinder.axes[i] = matrix * glm::vec4(m_axes[i], 1.0f);
-	}
-
-	cylinder.pointsCount = segments * 2;
-	memory = PhysicsAllocator::m_blockAllocator.allocateBlock(sizeof(glm::vec3) * cylinder.pointsCount);
-	cylinder.points = static_cast<glm::vec3 *>(memory);
-
-	for (int32_t i = 0; i < segments; i++)
+	for (int32_t i = 0; i < 3; ++i)
 	{
-		cylinder.points[i] = matrix * glm::vec4(m_points[i], 1.0f);
-		cylinder.points[i + segments] = matrix * glm::vec4(m_points[i + segments], 1.0f);
+		cylinder.axes[i] = cylinder.orientation * m_axes[i];
 	}
 
-	// std::cout << "center: (" << cylinder.center.x << ", " << cylinder.center.y << ", " << cylinder.center.z << ")\n";
-
-	// std::cout << "cylinder points!!\n";
-	// for (int i = 0; i < cylinder.points.size(); i++)
-	// {
-	// 	std::cout << "("<< cylinder.points[i].x << ", " << cylinder.points[i].y << ", " << cylinder.points[i].z <<
-	// ")\n";
-	// }
-	// std::cout << "bottom points)\n";
-	// for (int i = 1; i < cylinder.points.size(); i = i + 2)
-	// {
-	// 	std::cout  << "(" << cylinder.points[i].x << ", " << cylinder.points[i].y << ", " << cylinder.points[i].z <<
-	// ")\n";
-	// }
+	float halfHeight = m_height * 0.5f;
+	cylinder.halfSize = glm::vec3(halfHeight, m_radius, m_radius);
+	cylinder.boundingRadius = std::sqrt(halfHeight * halfHeight + m_radius * m_radius);
 
 	return cylinder;
 }
@@ -1,4 +1,5 @@
 #include "physics/CylinderToCylinderContact.h"
+#include "physics/CylinderShape.h"
 
 namespace ale
 {
@@ -18,118 +19,16 @@ Contact *CylinderToCylinderContact::create(Fixture *fixtureA, Fixture *fixtureB,
 		CylinderToCylinderContact(fixtureA, fixtureB, indexA, indexB);
 }
 
-glm::vec3 CylinderToCylinderContact::supportA(const ConvexInfo &cylinder, glm::vec3 dir)
+void CylinderToCylinderContact::destroy(Contact *contact)
 {
-	// 원기둥 정보
-	glm::vec3 center = cylinder.center;				   // 중심점
-	glm::vec3 axis = glm::normalize(cylinder.axes[0]); // 높이 축 (단위 벡터)
-	float height = cylinder.height;
-
-	// 1. 축 방향으로 윗면/아랫면 선택
-
-	bool isUpSide = true;
-	float dotResult = glm::dot(dir, axis);
-
-	if (dotResult < 0)
-	{
-		isUpSide = false;
-	}
-
-	glm::vec3 circleDir = dir - glm::dot(dir, axis) * axis; // 축에 수직한 방향
-
-	if (glm::length2(circleDir) > 1e-8f)
-	{
-		circleDir = glm::normalize(circleDir); // 정규화
-
-		int32_t maxIdx;
-		int32_t segments = 20;
-
-		float max = -FLT_MAX;
-		for (int32_t i = 0; i < segments; ++i)
-		{
-			dotResult = glm::dot(cylinder.points[i], dir);
-			if (dotResult > max)
-			{
-				maxIdx = i;
-				max = dotResult;
-			}
-		}
-
-		if (isUpSide == false)
-		{
-			maxIdx += segments;
-		}
-
-		return cylinder.points[maxIdx];
-	}
-	else
-	{
-		if (isUpSide)
-		{
-			return center + cylinder.axes[0] * height * 0.5f;
-		}
-		else
-		{
-			return center - cylinder.axes[0] * height * 0.5f;
-		}
-	}
+	static_cast<CylinderToCylinderContact *>(contact)->~CylinderToCylinderContact();
+	PhysicsAllocator::m_blockAllocator.freeBlock(contact, sizeof(CylinderToCylinderContact));
 }
 
-glm::vec3 CylinderToCylinderContact::supportB(const ConvexInfo &cylinder, glm::vec3 dir)
+// shape type을 고정한 GJK/EPA
+void CylinderToCylinderContact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
 {
-	// 원기둥 정보
-	glm::vec3 center = cylinder.center;				   // 중심점
-	glm::vec3 axis = glm::normalize(cylinder.axes[0]); // 높이 축 (단위 벡터)
-	float height = cylinder.height;
-
-	// 1. 축 방향으로 윗면/아랫면 선택
-
-	bool isUpSide = true;
-	float dotResult = glm::dot(dir, axis);
-
-	if (dotResult < 0)
-	{
-		isUpSide = false;
-	}
-
-	glm::vec3 circleDir = dir - glm::dot(dir, axis) * axis; // 축에 수직한 방향
-
-	if (glm::length2(circleDir) > 1e-8f)
-	{
-		circleDir = glm::normalize(circleDir); // 정규화
-
-		int32_t maxIdx;
-		int32_t segments = 20;
-
-		float max = -FLT_MAX;
-		for (int32_t i = 0; i < segments; ++i)
-		{
-			dotResult = glm::dot(cylinder.points[i], dir);
-			if (dotResult > max)
-			{
-				maxIdx = i;
-				max = dotResult;
-			}
-		}
-
-		if (isUpSide == false)
-		{
-			maxIdx += segments;
-		}
-
-		return cylinder.points[maxIdx];
-	}
-	else
-	{
-		if (isUpSide)
-		{
-			return center + cylinder.axes[0] * height * 0.5f;
-		}
-		else
-		{
-			return center - cylinder.axes[0] * height * 0.5f;
-		}
-	}
+	evaluateConvex<CylinderShape, CylinderShape>(manifold, transformA, transformB);
 }
 
 void CylinderToCylinderContact::findCollisionPoints(const ConvexInfo &cylinderA, const ConvexInfo &cylinderB,
@@ -8,6 +8,8 @@ DynamicTree::DynamicTree()
 	m_nodeCapacity = 16;
 	m_nodes.resize(m_nodeCapacity);
 	m_nodeCount = 0;
+	m_version = 0;
+	m_rotateCursor = 0;
 
 	for (int32_t i = 0; i < m_nodeCapacity - 1; ++i)
 	{
@@ -82,7 +84,7 @@ int32_t DynamicTree::createProxy(const AABB &aabb, void *userData)
 
 void DynamicTree::destroyProxy(int32_t proxyId)
 {
-	// remove leaf
+	removeLeaf(proxyId);
 	freeNode(proxyId);
 }
 
@@ -94,45 +96,61 @@ bool DynamicTree::moveProxy(int32_t proxyId, const AABB &aabb, const glm::vec3 &
 	}
 
 	removeLeaf(proxyId);
+	m_nodes[proxyId].aabb = computeFatAABB(aabb, displacement);
+	insertLeaf(proxyId);
+	return true;
+}
 
-	AABB b = aabb;
-	glm::vec3 r(0.1f);
-	b.lowerBound = b.lowerBound - r;
-	b.upperBound = b.upperBound + r;
-
-	glm::vec3 d = 2.0f * displacement;
-
-	if (d.x < 0.0f)
-	{
-		b.lowerBound.x += d.x;
-	}
-	else
+bool DynamicTree::enlargeProxy(int32_t proxyId, const AABB &aabb, const glm::vec3 &displacement)
+{
+	if (m_nodes[proxyId].aabb.contains(aabb))
 	{
-		b.upperBound.x += d.x;
+		return false;
 	}
 
-	if (d.y < 0.0f)
-	{
-		b.lowerBound.y += d.y;
-	}
-	else
+	m_nodes[proxyId].aabb = computeFatAABB(aabb, displacement);
+	m_refitLeaves.push_back(proxyId);
+	return true;
+}
+
+void DynamicTree::refit()
+{
+	if (m_refitLeaves.empty())
 	{
-		b.upperBound.y += d.y;
+		return;
 	}
 
-	if (d.z < 0.0f)
+	// 조상은 refit 시점에 찾으므로 그 사이에 insert / remove로 구조가 바뀌어도 됨
+	m_refitMarks.resize(m_nodeCapacity, 0);
+	m_refitNodes.clear();
+	for (int32_t leaf : m_refitLeaves)
 	{
-		b.lowerBound.z += d.z;
+		// 그 사이에 destroy된 leaf
+		if (m_nodes[leaf].height < 0)
+		{
+			continue;
+		}
+
+		int32_t index = m_nodes[leaf].parent;
+		while (index != nullNode && m_refitMarks[index] == 0)
+		{
+			m_refitMarks[index] = 1;
+			m_refitNodes.push_back(index);
+			index = m_nodes[index].parent;
+		}
 	}
-	else
+	m_refitLeaves.clear();
+
+	// 자식은 부모보다 높이가 낮으므로 높이 순으로 계산하면 한 번에 끝남
+	std::sort(m_refitNodes.begin(), m_refitNodes.end(),
+			  [this](int32_t a, int32_t b) { return m_nodes[a].height < m_nodes[b].height; });
+	for (int32_t nodeId : m_refitNodes)
 	{
-		b.upperBound.z += d.z;
+		TreeNode &node = m_nodes[nodeId];
+		node.aabb.combine(m_nodes[node.child1].aabb, m_nodes[node.child2].aabb);
+		m_refitMarks[nodeId] = 0;
 	}
-
-	m_nodes[proxyId].aabb = b;
-
-	insertLeaf(proxyId);
-	return true;
+	++m_version;
 }
 
 void *DynamicTree::getUserData(int32_t proxyId) const
@@ -146,8 +164,15 @@ const AABB &DynamicTree::getFatAABB(int32_t proxyId) const
 	return m_nodes[proxyId].aabb;
 }
 
+uint32_t DynamicTree::getVersion() const
+{
+	return m_version;
+}
+
 void DynamicTree::insertLeaf(int32_t leaf)
 {
+	++m_version;
+
 	if (m_root == nullNode)
 	{
 		m_root = leaf;
@@ -261,6 +286,8 @@ void DynamicTree::insertLeaf(int32_t leaf)
 
 void DynamicTree::removeLeaf(int32_t leaf)
 {
+	++m_version;
+
 	if (leaf == m_root)
 	{
 		m_root = nullNode;
@@ -317,6 +344,466 @@ void DynamicTree::removeLeaf(int32_t leaf)
 	// printDynamicTree(root);
 }
 
+void DynamicTree::rebuild()
+{
+	if (m_root == nullNode)
+	{
+		return;
+	}
+
+	std::vector<int32_t> leaves;
+	collectLeaves(leaves);
+
+	++m_version;
+	m_root = buildSubtree(leaves.data(), static_cast<int32_t>(leaves.size()));
+	m_nodes[m_root].parent = nullNode;
+}
+
+void DynamicTree::rebuildBottomUp()
+{
+	if (m_root == nullNode)
+	{
+		return;
+	}
+
+	std::vector<int32_t> nodes;
+	collectLeaves(nodes);
+	int32_t count = static_cast<int32_t>(nodes.size());
+
+	// leaf 중심의 Morton code 순서로 정렬해 공간에서 가까운 leaf가 배열에서도 가깝게 놓이게 함
+	glm::vec3 centerMin(FLT_MAX);
+	glm::vec3 centerMax(-FLT_MAX);
+	for (int32_t leaf : nodes)
+	{
+		const AABB &aabb = m_nodes[leaf].aabb;
+		glm::vec3 center = (aabb.lowerBound + aabb.upperBound) * 0.5f;
+		centerMin = glm::min(centerMin, center);
+		centerMax = glm::max(centerMax, center);
+	}
+	glm::vec3 centerScale = glm::vec3(1023.0f) / glm::max(centerMax - centerMin, glm::vec3(FLT_EPSILON));
+
+	// 10 bit 값의 각 bit 사이에 0을 두 개씩 끼워 넣음
+	auto expandBits = [](uint32_t value) {
+		value = (value * 0x00010001u) & 0xFF0000FFu;
+		value = (value * 0x00000101u) & 0x0F00F00Fu;
+		value = (value * 0x00000011u) & 0xC30C30C3u;
+		value = (value * 0x00000005u) & 0x49249249u;
+		return value;
+	};
+
+	std::vector<std::pair<uint32_t, int32_t>> mortonCodes(count);
+	for (int32_t i = 0; i < count; ++i)
+	{
+		const AABB &aabb = m_nodes[nodes[i]].aabb;
+		glm::vec3 cell = ((aabb.lowerBound + aabb.upperBound) * 0.5f - centerMin) * centerScale;
+		uint32_t code = (expandBits(static_cast<uint32_t>(cell.x)) << 2) |
+						(expandBits(static_cast<uint32_t>(cell.y)) << 1) | expandBits(static_cast<uint32_t>(cell.z));
+		mortonCodes[i] = {code, nodes[i]};
+	}
+	std::sort(mortonCodes.begin(), mortonCodes.end());
+	for (int32_t i = 0; i < count; ++i)
+	{
+		nodes[i] = mortonCodes[i].second;
+	}
+
+	// 각 node가 앞뒤 BOTTOM_UP_SEARCH_RADIUS개 안에서 합친 표면적이 가장 작은 짝을 고르고 서로를 고른 쌍만 묶음
+	// 표면적이 같으면 배열에서 더 가까운 쌍, 거리도 같으면 앞쪽 index가 짝수인 쌍을 골라
+	// 같은 aabb가 많아도 (0, 1), (2, 3)처럼 나란히 묶임
+	// 비교 기준이 두 node에 대칭이므로 기준이 가장 작은 쌍은 항상 서로를 골라 pass마다 적어도 한 쌍은 묶임
+	std::vector<int32_t> partners(count);
+	++m_version;
+	while (count > 1)
+	{
+		for (int32_t i = 0; i < count; ++i)
+		{
+			int32_t begin = std::max(i - BOTTOM_UP_SEARCH_RADIUS, 0);
+			int32_t end = std::min(i + BOTTOM_UP_SEARCH_RADIUS + 1, count);
+			float bestCost = FLT_MAX;
+			int32_t bestTie = INT32_MAX;
+			for (int32_t j = begin; j < end; ++j)
+			{
+				if (j == i)
+				{
+					continue;
+				}
+
+				AABB aabb;
+				aabb.combine(m_nodes[nodes[i]].aabb, m_nodes[nodes[j]].aabb);
+				float cost = aabb.getSurface();
+				int32_t tie = std::abs(j - i) * 2 + (std::min(i, j) & 1);
+				if (cost < bestCost || (cost == bestCost && tie < bestTie))
+				{
+					bestCost = cost;
+					bestTie = tie;
+					partners[i] = j;
+				}
+			}
+		}
+
+		// 묶은 parent는 앞쪽 자리를 이어받아 Morton 순서를 유지, 뒤쪽 자리는 지우고 앞으로 당김
+		int32_t newCount = 0;
+		for (int32_t i = 0; i < count; ++i)
+		{
+			int32_t partner = partners[i];
+			if (partners[partner] != i)
+			{
+				nodes[newCount++] = nodes[i];
+			}
+			else if (i < partner)
+			{
+				nodes[newCount++] = createParent(nodes[i], nodes[partner]);
+			}
+		}
+		count = newCount;
+	}
+
+	m_root = nodes[0];
+	m_nodes[m_root].parent = nullNode;
+}
+
+int32_t DynamicTree::rotate(int32_t budget)
+{
+	if (m_root == nullNode)
+	{
+		return 0;
+	}
+
+	// node 배열을 순서대로 돌며 지난번에 멈춘 곳부터 이어서 검사
+	int32_t rotationCount = 0;
+	for (int32_t visited = 0; visited < m_nodeCapacity && budget > 0; ++visited)
+	{
+		int32_t nodeId = m_rotateCursor;
+		m_rotateCursor = (m_rotateCursor + 1) % m_nodeCapacity;
+
+		const TreeNode &node = m_nodes[nodeId];
+		if (node.height < 2)
+		{
+			continue;
+		}
+		--budget;
+
+		// 자식 B, C 중 internal node의 자식과 다른 쪽 자식을 바꿨을 때 그 internal node의 표면적이 가장 많이 줄어드는 경우
+		int32_t children[2] = {node.child1, node.child2};
+		float bestGain = 0.0f;
+		int32_t bestInner = nullNode;
+		int32_t bestSwapIn = nullNode;
+		int32_t bestSwapOut = nullNode;
+		for (int32_t i = 0; i < 2; ++i)
+		{
+			int32_t inner = children[i];
+			int32_t swapOut = children[1 - i];
+			const TreeNode &innerNode = m_nodes[inner];
+			if (innerNode.isLeaf())
+			{
+				continue;
+			}
+
+			float innerCost = innerNode.aabb.getSurface();
+			int32_t grandChildren[2] = {innerNode.child1, innerNode.child2};
+			for (int32_t j = 0; j < 2; ++j)
+			{
+				// balance가 다시 되돌리지 않도록 회전 후에도 두 node의 자식 높이 차가 1 이하인 경우만 허용
+				int32_t swapOutHeight = m_nodes[swapOut].height;
+				int32_t keptHeight = m_nodes[grandChildren[1 - j]].height;
+				int32_t innerHeight = std::max(swapOutHeight, keptHeight) + 1;
+				if (std::abs(swapOutHeight - keptHeight) > 1 ||
+					std::abs(innerHeight - m_nodes[grandChildren[j]].height) > 1)
+				{
+					continue;
+				}
+
+				AABB aabb;
+				aabb.combine(m_nodes[swapOut].aabb, m_nodes[grandChildren[1 - j]].aabb);
+				float gain = innerCost - aabb.getSurface();
+				if (gain > bestGain)
+				{
+					bestGain = gain;
+					bestInner = inner;
+					bestSwapIn = grandChildren[j];
+					bestSwapOut = swapOut;
+				}
+			}
+		}
+
+		if (bestInner != nullNode)
+		{
+			rotateNodes(nodeId, bestSwapOut, bestInner, bestSwapIn);
+			++rotationCount;
+		}
+	}
+
+	if (rotationCount > 0)
+	{
+		++m_version;
+	}
+	return rotationCount;
+}
+
+float DynamicTree::getTotalCost() const
+{
+	float cost = 0.0f;
+	for (int32_t i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height > 0)
+		{
+			cost += m_nodes[i].aabb.getSurface();
+		}
+	}
+	return cost;
+}
+
+int32_t DynamicTree::getHeight() const
+{
+	if (m_root == nullNode)
+	{
+		return 0;
+	}
+	return m_nodes[m_root].height;
+}
+
+AABB DynamicTree::computeFatAABB(const AABB &aabb, const glm::vec3 &displacement) const
+{
+	AABB b = aabb;
+	glm::vec3 r(0.1f);
+	b.lowerBound = b.lowerBound - r;
+	b.upperBound = b.upperBound + r;
+
+	glm::vec3 d = 2.0f * displacement;
+
+	if (d.x < 0.0f)
+	{
+		b.lowerBound.x += d.x;
+	}
+	else
+	{
+		b.upperBound.x += d.x;
+	}
+
+	if (d.y < 0.0f)
+	{
+		b.lowerBound.y += d.y;
+	}
+	else
+	{
+		b.upperBound.y += d.y;
+	}
+
+	if (d.z < 0.0f)
+	{
+		b.lowerBound.z += d.z;
+	}
+	else
+	{
+		b.upperBound.z += d.z;
+	}
+
+	return b;
+}
+
+void DynamicTree::collectLeaves(std::vector<int32_t> &leaves)
+{
+	leaves.clear();
+	leaves.reserve(m_nodeCount);
+	for (int32_t i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height < 0)
+		{
+			continue;
+		}
+
+		if (m_nodes[i].isLeaf())
+		{
+			leaves.push_back(i);
+		}
+		else
+		{
+			freeNode(i);
+		}
+	}
+}
+
+int32_t DynamicTree::createParent(int32_t child1, int32_t child2)
+{
+	int32_t nodeId = allocateNode();
+
+	m_nodes[nodeId].child1 = child1;
+	m_nodes[nodeId].child2 = child2;
+	m_nodes[nodeId].aabb.combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+	m_nodes[nodeId].height = std::max(m_nodes[child1].height, m_nodes[child2].height) + 1;
+	m_nodes[child1].parent = nodeId;
+	m_nodes[child2].parent = nodeId;
+	return nodeId;
+}
+
+void DynamicTree::rotateNodes(int32_t nodeId, int32_t swapOut, int32_t inner, int32_t swapIn)
+{
+	TreeNode &node = m_nodes[nodeId];
+	TreeNode &innerNode = m_nodes[inner];
+
+	if (node.child1 == swapOut)
+	{
+		node.child1 = swapIn;
+	}
+	else
+	{
+		node.child2 = swapIn;
+	}
+
+	if (innerNode.child1 == swapIn)
+	{
+		innerNode.child1 = swapOut;
+	}
+	else
+	{
+		innerNode.child2 = swapOut;
+	}
+
+	m_nodes[swapIn].parent = nodeId;
+	m_nodes[swapOut].parent = inner;
+
+	// node의 aabb는 그대로, inner의 aabb와 높이만 바뀜
+	innerNode.aabb.combine(m_nodes[innerNode.child1].aabb, m_nodes[innerNode.child2].aabb);
+	innerNode.height = std::max(m_nodes[innerNode.child1].height, m_nodes[innerNode.child2].height) + 1;
+
+	// 높이가 바뀌지 않는 조상까지만 갱신
+	int32_t index = nodeId;
+	while (index != nullNode)
+	{
+		TreeNode &ancestor = m_nodes[index];
+		int32_t height = std::max(m_nodes[ancestor.child1].height, m_nodes[ancestor.child2].height) + 1;
+		if (height == ancestor.height && index != nodeId)
+		{
+			break;
+		}
+		ancestor.height = height;
+		index = ancestor.parent;
+	}
+}
+
+int32_t DynamicTree::buildSubtree(int32_t *leaves, int32_t count)
+{
+	if (count == 1)
+	{
+		return leaves[0];
+	}
+
+	// leaf 중심이 가장 넓게 퍼진 축을 고름
+	glm::vec3 centerMin(FLT_MAX);
+	glm::vec3 centerMax(-FLT_MAX);
+	for (int32_t i = 0; i < count; ++i)
+	{
+		const AABB &aabb = m_nodes[leaves[i]].aabb;
+		glm::vec3 center = (aabb.lowerBound + aabb.upperBound) * 0.5f;
+		centerMin = glm::min(centerMin, center);
+		centerMax = glm::max(centerMax, center);
+	}
+
+	glm::vec3 centerExtent = centerMax - centerMin;
+	int32_t axis = 0;
+	if (centerExtent.y > centerExtent[axis])
+	{
+		axis = 1;
+	}
+	if (centerExtent.z > centerExtent[axis])
+	{
+		axis = 2;
+	}
+
+	int32_t split = count / 2;
+	if (centerExtent[axis] > 0.0f)
+	{
+		// 중심 좌표로 bin에 나눠 담고, bin 경계마다 양쪽 (표면적 * leaf 수) 합이 가장 작은 곳에서 자름
+		AABB binAABBs[SAH_BIN_COUNT];
+		int32_t binCounts[SAH_BIN_COUNT] = {};
+		float binScale = static_cast<float>(SAH_BIN_COUNT) / centerExtent[axis];
+
+		auto getBin = [&](int32_t leaf) {
+			const AABB &aabb = m_nodes[leaf].aabb;
+			float center = (aabb.lowerBound[axis] + aabb.upperBound[axis]) * 0.5f;
+			int32_t bin = static_cast<int32_t>((center - centerMin[axis]) * binScale);
+			return std::min(bin, SAH_BIN_COUNT - 1);
+		};
+
+		for (int32_t i = 0; i < count; ++i)
+		{
+			int32_t bin = getBin(leaves[i]);
+			if (binCounts[bin] == 0)
+			{
+				binAABBs[bin] = m_nodes[leaves[i]].aabb;
+			}
+			else
+			{
+				binAABBs[bin].combine(m_nodes[leaves[i]].aabb);
+			}
+			++binCounts[bin];
+		}
+
+		// rightCosts[i]: bin [i, SAH_BIN_COUNT)를 묶었을 때의 비용
+		float rightCosts[SAH_BIN_COUNT];
+		AABB rightAABB;
+		int32_t rightCount = 0;
+		for (int32_t i = SAH_BIN_COUNT - 1; i > 0; --i)
+		{
+			if (binCounts[i] > 0)
+			{
+				if (rightCount == 0)
+				{
+					rightAABB = binAABBs[i];
+				}
+				else
+				{
+					rightAABB.combine(binAABBs[i]);
+				}
+				rightCount += binCounts[i];
+			}
+			rightCosts[i] = rightCount == 0 ? 0.0f : rightAABB.getSurface() * rightCount;
+		}
+
+		int32_t bestBin = 0;
+		float bestCost = FLT_MAX;
+		AABB leftAABB;
+		int32_t leftCount = 0;
+		for (int32_t i = 1; i < SAH_BIN_COUNT; ++i)
+		{
+			if (binCounts[i - 1] > 0)
+			{
+				if (leftCount == 0)
+				{
+					leftAABB = binAABBs[i - 1];
+				}
+				else
+				{
+					leftAABB.combine(binAABBs[i - 1]);
+				}
+				leftCount += binCounts[i - 1];
+			}
+
+			if (leftCount == 0 || leftCount == count)
+			{
+				continue;
+			}
+
+			float cost = leftAABB.getSurface() * leftCount + rightCosts[i];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestBin = i;
+			}
+		}
+
+		if (bestBin > 0)
+		{
+			int32_t *middle =
+				std::partition(leaves, leaves + count, [&](int32_t leaf) { return getBin(leaf) < bestBin; });
+			split = static_cast<int32_t>(middle - leaves);
+		}
+	}
+
+	int32_t child1 = buildSubtree(leaves, split);
+	int32_t child2 = buildSubtree(leaves + split, count - split);
+	return createParent(child1, child2);
+}
+
 float DynamicTree::getInsertionCostForLeaf(const AABB &leafAABB, int32_t child, float inheritedCost)
 {
 	AABB aabb;
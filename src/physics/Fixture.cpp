@@ -1,6 +1,10 @@
 #include "physics/Fixture.h"
+#include "physics/BoxShape.h"
 #include "physics/BroadPhase.h"
+#include "physics/CapsuleShape.h"
+#include "physics/CylinderShape.h"
 #include "physics/Rigidbody.h"
+#include "physics/SphereShape.h"
 
 namespace ale
 {
@@ -43,10 +47,34 @@ void Fixture::destroy()
 		m_proxies[i].fixture = nullptr;
 		// delete userData
 	}
-	m_shape->~Shape();
-
 	PhysicsAllocator::m_blockAllocator.freeBlock(m_proxies, sizeof(FixtureProxy) * m_proxyCount);
-	PhysicsAllocator::m_blockAllocator.freeBlock(m_shape, sizeof(Shape));
+	m_proxies = nullptr;
+	m_proxyCount = 0;
+
+	// shape는 clone 할 때의 크기로 반환
+	int32_t shapeSize = 0;
+	switch (m_shape->getType())
+	{
+	case EType::SPHERE:
+		shapeSize = sizeof(SphereShape);
+		break;
+	case EType::BOX:
+	case EType::GROUND:
+		shapeSize = sizeof(BoxShape);
+		break;
+	case EType::CYLINDER:
+		shapeSize = sizeof(CylinderShape);
+		break;
+	case EType::CAPSULE:
+		shapeSize = sizeof(CapsuleShape);
+		break;
+	default:
+		break;
+	}
+
+	m_shape->~Shape();
+	PhysicsAllocator::m_blockAllocator.freeBlock(m_shape, shapeSize);
+	m_shape = nullptr;
 }
 
 void Fixture::createProxies(BroadPhase *broadPhase)
@@ -55,7 +83,8 @@ void Fixture::createProxies(BroadPhase *broadPhase)
 	for (int32_t i = 0; i < m_proxyCount; ++i)
 	{
 		m_shape->computeAABB(&m_proxies[i].aabb, m_body->getTransform());
-		m_proxies[i].proxyId = broadPhase->createProxy(m_proxies[i].aabb, &(m_proxies[i]));
+		m_proxies[i].proxyId = broadPhase->createProxy(m_proxies[i].aabb, &(m_proxies[i]),
+													   m_body->getType() == EBodyType::STATIC_BODY);
 		m_proxies[i].fixture = this;
 		m_proxies[i].childIndex = i;
 	}
@@ -63,6 +92,12 @@ void Fixture::createProxies(BroadPhase *broadPhase)
 
 void Fixture::destroyProxies(BroadPhase *broadPhase)
 {
+	for (int32_t i = 0; i < m_proxyCount; ++i)
+	{
+		FixtureProxy &proxy = m_proxies[i];
+		broadPhase->destroyProxy(proxy.proxyId);
+		proxy.proxyId = BroadPhase::NULL_PROXY;
+	}
 }
 
 void Fixture::synchronize(BroadPhase *broadPhase, const Transform &xf1, const Transform &xf2)
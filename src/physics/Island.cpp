@@ -8,34 +8,26 @@ const int32_t Island::VELOCITY_ITERATION = 10;
 const int32_t Island::POSITION_ITERATION = 10;
 const float Island::STOP_LINEAR_VELOCITY = 1.0f;
 const float Island::STOP_ANGULAR_VELOCITY = 0.1f;
+const int32_t Island::PARALLEL_SOLVE_CONTACT_COUNT = 256;
 
-Island::Island(int32_t bodyCount, int32_t contactCount)
+Island::Island(Rigidbody **bodies, Contact **contacts, ContactBodyIndex *contactIndices)
+	: m_bodies(bodies), m_contacts(contacts), m_contactIndices(contactIndices), m_positions(nullptr),
+	  m_velocities(nullptr), m_bodyCount(0), m_contactCount(0)
 {
-	m_bodyCount = 0;
-	m_contactCount = 0;
-	m_bodies =
-		static_cast<Rigidbody **>(PhysicsAllocator::m_stackAllocator.allocateStack(sizeof(Rigidbody *) * bodyCount));
-	m_contacts =
-		static_cast<Contact **>(PhysicsAllocator::m_stackAllocator.allocateStack(sizeof(Contact *) * contactCount));
 }
 
-void Island::destroy()
-{
-	PhysicsAllocator::m_stackAllocator.freeStack();
-	PhysicsAllocator::m_stackAllocator.freeStack();
-}
-
-void Island::solve(float duration)
+// 여러 island가 동시에 solve 될 수 있으므로 공유 자원(broadphase 등)은 건드리지 않는다
+// 스택 메모리는 호출한 worker의 allocator에서만 할당
+// scheduler가 주어지면 contact들을 color로 나눠 island 내부를 병렬로 solve
+void Island::solve(float duration, StackAllocator &allocator, TaskScheduler *scheduler)
 {
 	if (m_bodyCount == 1)
 	{
 		return;
 	}
 	// std::cout << "\n\n\nIsland Solve Start!!!!!\n";
-	m_positions =
-		static_cast<Position *>(PhysicsAllocator::m_stackAllocator.allocateStack(sizeof(Position) * m_bodyCount));
-	m_velocities =
-		static_cast<Velocity *>(PhysicsAllocator::m_stackAllocator.allocateStack(sizeof(Velocity) * m_bodyCount));
+	m_positions = static_cast<Position *>(allocator.allocateStack(sizeof(Position) * m_bodyCount));
+	m_velocities = static_cast<Velocity *>(allocator.allocateStack(sizeof(Velocity) * m_bodyCount));
 
 	// 힘을 적용하여 속도, 위치, 회전 업데이트
 	for (int32_t i = 0; i < m_bodyCount; i++)
@@ -66,20 +58,48 @@ void Island::solve(float duration)
 		// }
 	}
 
-	ContactSolver contactSolver(duration, m_contacts, m_positions, m_velocities, m_bodyCount, m_contactCount);
+	ContactSolver contactSolver(duration, m_contacts, m_contactIndices, m_positions, m_velocities, m_bodyCount,
+								m_contactCount, allocator);
+
+	contactSolver.initializeVelocityConstraints();
+
+	// 이전 step의 충격량으로 warm start
+	if (scheduler != nullptr)
+	{
+		contactSolver.colorConstraints();
+		contactSolver.warmStart(*scheduler);
+	}
+	else
+	{
+		contactSolver.warmStart();
+	}
 
 	// 속도 제약 반복 횟수만큼 반복
 	for (int32_t i = 0; i < VELOCITY_ITERATION; ++i)
 	{
 		// std::cout << "iteration[" << i << "]\n";
 		// 충돌 속도 제약 해결
-		contactSolver.solveVelocityConstraints();
+		if (scheduler != nullptr)
+		{
+			contactSolver.solveVelocityConstraints(*scheduler);
+		}
+		else
+		{
+			contactSolver.solveVelocityConstraints();
+		}
 	}
 
 	// 위치 제약 처리 반복
 	for (int32_t i = 0; i < POSITION_ITERATION; ++i)
 	{
-		contactSolver.solvePositionConstraints();
+		if (scheduler != nullptr)
+		{
+			contactSolver.solvePositionConstraints(*scheduler);
+		}
+		else
+		{
+			contactSolver.solvePositionConstraints();
+		}
 	}
 
 	contactSolver.checkSleepContact();
@@ -126,7 +146,6 @@ void Island::solve(float duration)
 		body->setPosition(m_positions[i].position + m_positions[i].positionBuffer);
 		body->setLinearVelocity(m_velocities[i].linearVelocity);
 		body->setAngularVelocity(m_velocities[i].angularVelocity);
-		body->synchronizeFixtures();
 	}
 
 	contactSolver.destroy();
@@ -137,12 +156,26 @@ void Island::solve(float duration)
 		m_velocities[i].~Velocity();
 	}
 
-	PhysicsAllocator::m_stackAllocator.freeStack();
-	PhysicsAllocator::m_stackAllocator.freeStack();
+	allocator.freeStack();
+	allocator.freeStack();
 
 	// std::cout << "island end!!!\n\n\n";
 }
 
+// broadphase 갱신은 모든 island의 solve가 끝난 뒤 한 스레드에서 처리
+void Island::synchronizeFixtures()
+{
+	if (m_bodyCount == 1)
+	{
+		return;
+	}
+
+	for (int32_t i = 0; i < m_bodyCount; ++i)
+	{
+		m_bodies[i]->synchronizeFixtures();
+	}
+}
+
 void Island::add(Rigidbody *body)
 {
 	body->setIslandIndex(m_bodyCount);
@@ -156,12 +189,15 @@ void Island::add(Contact *contact)
 	++m_contactCount;
 }
 
-void Island::clear()
+// DFS가 끝난 직후(static body의 islandIndex가 이 island 기준일 때) 호출해야 함
+void Island::storeContactIndices()
 {
-	memset(m_bodies, 0, sizeof(Rigidbody *) * m_bodyCount);
-	memset(m_contacts, 0, sizeof(Contact *) * m_contactCount);
-	m_bodyCount = 0;
-	m_contactCount = 0;
+	for (int32_t i = 0; i < m_contactCount; ++i)
+	{
+		Contact *contact = m_contacts[i];
+		m_contactIndices[i].indexA = contact->getFixtureA()->getBody()->getIslandIndex();
+		m_contactIndices[i].indexB = contact->getFixtureB()->getBody()->getIslandIndex();
+	}
 }
 
 } // namespace ale
\ No newline at end of file
@@ -78,6 +78,16 @@ void Rigidbody::synchronizeFixtures()
 	}
 }
 
+void Rigidbody::destroyProxies()
+{
+	BroadPhase *broadPhase = &m_world->m_contactManager.m_broadPhase;
+
+	for (int32_t i = 0; i < m_fixtureCount; ++i)
+	{
+		m_fixtures[i].destroyProxies(broadPhase);
+	}
+}
+
 // Update acceleration by Adding force to Body
 void Rigidbody::integrate(float duration)
 {
@@ -23,27 +23,24 @@ int32_t SphereShape::getChildCount() const
 
 void SphereShape::computeAABB(AABB *aabb, const Transform &xf) const
 {
-	// get min, max vertex
-	glm::vec3 upper = xf.position + glm::vec3(m_radius);
-	glm::vec3 lower = xf.position - glm::vec3(m_radius);
-
-	// std::cout << "upper: " << upper.x << ", " << upper.y << ", " << upper.z << '\n';
-	// std::cout << "lower: " << lower.x << ", " << lower.y << ", " << lower.z << '\n';
+	glm::vec3 center = xf.position + glm::normalize(xf.orientation) * m_center;
+	glm::vec3 upper = center + glm::vec3(m_radius);
+	glm::vec3 lower = center - glm::vec3(m_radius);
 
 	aabb->upperBound = upper + glm::vec3(0.1f);
 	aabb->lowerBound = lower - glm::vec3(0.1f);
 }
 
-void SphereShape::setShapeFeatures(std::vector<Vertex> &vertices)
+void SphereShape::setShapeFeatures(const std::vector<glm::vec3> &positions)
 {
 	// welzl 알고리즘 나중에 적용 고려
 	m_center = glm::vec3(0.0f);
 	float distance = 0.0f;
 
-	for (const Vertex &vertex : vertices)
+	for (const glm::vec3 &position : positions)
 	{
-		distance = std::max(vertex.position.x * vertex.position.x + vertex.position.y * vertex.position.y +
-								vertex.position.z * vertex.position.z,
+		distance = std::max(position.x * position.x + position.y * position.y +
+								position.z * position.z,
 							distance);
 	}
 
@@ -53,8 +50,18 @@ void SphereShape::setShapeFeatures(std::vector<Vertex> &vertices)
 ConvexInfo SphereShape::getShapeInfo(const Transform &transform) const
 {
 	ConvexInfo sphere;
+	sphere.shape = this;
+	sphere.position = transform.position;
+	sphere.orientation = glm::normalize(transform.orientation);
 	sphere.radius = m_radius;
-	sphere.center = transform.toMatrix() * glm::vec4(m_center, 1.0f);
+	sphere.center = sphere.position + sphere.orientation * m_center;
+	sphere.boundingRadius = m_radius;
+
+	glm::mat3 rotation = glm::toMat3(sphere.orientation);
+	sphere.axes[0] = rotation[0];
+	sphere.axes[1] = rotation[1];
+	sphere.axes[2] = rotation[2];
+	sphere.halfSize = glm::vec3(m_radius);
 	return sphere;
 }
 
@@ -16,23 +16,241 @@ Contact *SphereToBoxContact::create(Fixture *fixtureA, Fixture *fixtureB, int32_
 	return new (static_cast<SphereToBoxContact *>(memory)) SphereToBoxContact(fixtureA, fixtureB, indexA, indexB);
 }
 
-glm::vec3 SphereToBoxContact::supportA(const ConvexInfo &sphere, glm::vec3 dir)
+void SphereToBoxContact::destroy(Contact *contact)
 {
-	return sphere.center + dir * sphere.radius;
+	static_cast<SphereToBoxContact *>(contact)->~SphereToBoxContact();
+	PhysicsAllocator::m_blockAllocator.freeBlock(contact, sizeof(SphereToBoxContact));
 }
 
-glm::vec3 SphereToBoxContact::supportB(const ConvexInfo &box, glm::vec3 dir)
+// 구 중심과 box OBB를 SoA로 모아 box 위 최근접점을 SIMD로 구한 뒤 sphere batch kernel로 검사
+// 중심이 box 안에 들어간 contact만 evaluate로 따로 처리
+void SphereToBoxContact::updateContacts(ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+										const ManifoldReuseThreshold &reuseThreshold)
 {
-	float dotAxes[3] = {glm::dot(box.axes[0], dir) > 0 ? 1.0f : -1.0f, glm::dot(box.axes[1], dir) > 0 ? 1.0f : -1.0f,
-						glm::dot(box.axes[2], dir) > 0 ? 1.0f : -1.0f};
+	SphereBatch batch;
+	SphereBoxBatch boxBatch;
+	int32_t i = 0;
+	while (i < count)
+	{
+		batch.count = 0;
+		for (; i < count && batch.count < SPHERE_BATCH_SIZE; ++i)
+		{
+			ContactUpdate &contactUpdate = contactUpdates[order[i]];
+			SphereToBoxContact *contact = static_cast<SphereToBoxContact *>(contactUpdate.contact);
+			const Transform &transformA = contact->m_fixtureA->getBody()->getTransform();
+			const Transform &transformB = contact->m_fixtureB->getBody()->getTransform();
+
+			if (contact->reuseManifold(reuseThreshold, transformA, transformB))
+			{
+				contactUpdate.touching = true;
+				continue;
+			}
+
+			const SphereShape *sphere = static_cast<const SphereShape *>(contact->m_fixtureA->getShape());
+			glm::vec3 center = transformA.position + glm::normalize(transformA.orientation) * sphere->m_center;
+			ConvexInfo box = contact->m_fixtureB->getShape()->getShapeInfo(transformB);
+
+			int32_t lane = batch.count;
+			batch.centerAX[lane] = center.x;
+			batch.centerAY[lane] = center.y;
+			batch.centerAZ[lane] = center.z;
+			batch.radiusA[lane] = sphere->m_radius;
+			boxBatch.centerX[lane] = box.center.x;
+			boxBatch.centerY[lane] = box.center.y;
+			boxBatch.centerZ[lane] = box.center.z;
+			for (int32_t axis = 0; axis < 3; ++axis)
+			{
+				boxBatch.axisX[axis][lane] = box.axes[axis].x;
+				boxBatch.axisY[axis][lane] = box.axes[axis].y;
+				boxBatch.axisZ[axis][lane] = box.axes[axis].z;
+				boxBatch.halfSize[axis][lane] = box.halfSize[axis];
+			}
+			batch.contactUpdates[lane] = &contactUpdate;
+			++batch.count;
+		}
+
+		computeClosestPoints(batch, boxBatch);
+		computeSphereContacts(batch);
+
+		for (int32_t lane = 0; lane < batch.count; ++lane)
+		{
+			ContactUpdate *contactUpdate = batch.contactUpdates[lane];
+			SphereToBoxContact *contact = static_cast<SphereToBoxContact *>(contactUpdate->contact);
+
+			if (boxBatch.isInside[lane])
+			{
+				contactUpdate->touching = contact->updateInsideManifold(reuseThreshold);
+				continue;
+			}
+
+			uint32_t typeId = (static_cast<uint32_t>(contact->m_fixtureA->getType()) << 18) |
+							  (static_cast<uint32_t>(contact->m_fixtureB->getType()) << 13);
+			uint32_t feature = static_cast<uint32_t>(boxBatch.feature[lane]);
+			contactUpdate->touching = contact->applySphereContact(reuseThreshold, batch, lane, typeId | feature);
+		}
+	}
+}
+
+// evaluate의 clamp를 SIMD_WIDTH개씩 계산해서 최근접점을 batch의 B(반지름 0)에 저장
+void SphereToBoxContact::computeClosestPoints(SphereBatch &batch, SphereBoxBatch &boxBatch)
+{
+	// 남는 lane은 크기 0인 box와 같은 위치의 구로 채움
+	int32_t paddedCount = (batch.count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+	for (int32_t i = batch.count; i < paddedCount; ++i)
+	{
+		batch.centerAX[i] = batch.centerAY[i] = batch.centerAZ[i] = batch.radiusA[i] = 0.0f;
+		boxBatch.centerX[i] = boxBatch.centerY[i] = boxBatch.centerZ[i] = 0.0f;
+		for (int32_t axis = 0; axis < 3; ++axis)
+		{
+			boxBatch.axisX[axis][i] = boxBatch.axisY[axis][i] = boxBatch.axisZ[axis][i] = 0.0f;
+			boxBatch.halfSize[axis][i] = 0.0f;
+		}
+	}
 
-	glm::vec3 point = box.center;
-	for (int i = 0; i < 3; ++i)
+	const SimdFloat zero = simdSet(0.0f);
+	const SimdFloat one = simdSet(1.0f);
+	const SimdFloat two = simdSet(2.0f);
+	const float featureScale[3] = {1.0f, 3.0f, 9.0f};
+
+	for (int32_t i = 0; i < paddedCount; i = i + SIMD_WIDTH)
 	{
-		point += box.axes[i] * (dotAxes[i] * box.halfSize[i]);
+		SimdFloat boxCenterX = simdLoad(boxBatch.centerX + i);
+		SimdFloat boxCenterY = simdLoad(boxBatch.centerY + i);
+		SimdFloat boxCenterZ = simdLoad(boxBatch.centerZ + i);
+		SimdFloat distanceX = simdLoad(batch.centerAX + i) - boxCenterX;
+		SimdFloat distanceY = simdLoad(batch.centerAY + i) - boxCenterY;
+		SimdFloat distanceZ = simdLoad(batch.centerAZ + i) - boxCenterZ;
+
+		SimdFloat closestX = boxCenterX;
+		SimdFloat closestY = boxCenterY;
+		SimdFloat closestZ = boxCenterZ;
+		SimdFloat feature = zero;
+		SimdFloat isOutside = simdLess(one, zero);
+
+		for (int32_t axis = 0; axis < 3; ++axis)
+		{
+			SimdFloat axisX = simdLoad(boxBatch.axisX[axis] + i);
+			SimdFloat axisY = simdLoad(boxBatch.axisY[axis] + i);
+			SimdFloat axisZ = simdLoad(boxBatch.axisZ[axis] + i);
+			SimdFloat halfSize = simdLoad(boxBatch.halfSize[axis] + i);
+			SimdFloat value = distanceX * axisX + distanceY * axisY + distanceZ * axisZ;
+
+			SimdFloat isOver = simdLess(halfSize, value);
+			SimdFloat isUnder = simdLess(value, zero - halfSize);
+			isOutside = simdOr(isOutside, simdOr(isOver, isUnder));
+			value = simdMin(simdMax(value, zero - halfSize), halfSize);
+
+			// 축마다 0: 음의 면 바깥, 1: 범위 안, 2: 양의 면 바깥
+			SimdFloat digit = simdSelect(isOver, two, simdSelect(isUnder, zero, one));
+			feature = feature + digit * simdSet(featureScale[axis]);
+
+			closestX = closestX + axisX * value;
+			closestY = closestY + axisY * value;
+			closestZ = closestZ + axisZ * value;
+		}
+
+		simdStore(batch.centerBX + i, closestX);
+		simdStore(batch.centerBY + i, closestY);
+		simdStore(batch.centerBZ + i, closestZ);
+		simdStore(batch.radiusB + i, zero);
+		simdStore(boxBatch.feature + i, feature);
+
+		int32_t mask = simdMoveMask(isOutside);
+		for (int32_t j = 0; j < SIMD_WIDTH; ++j)
+		{
+			boxBatch.isInside[i + j] = ((mask >> j) & 1) == 0;
+		}
 	}
+}
+
+// 중심이 box 안에 들어간 contact를 evaluate로 계산, reuseManifold는 batch에 모을 때 이미 검사함
+bool SphereToBoxContact::updateInsideManifold(const ManifoldReuseThreshold &reuseThreshold)
+{
+	const Transform &transformA = m_fixtureA->getBody()->getTransform();
+	const Transform &transformB = m_fixtureB->getBody()->getTransform();
+
+	int32_t oldPointsCount = m_manifold.pointsCount;
+	ManifoldPoint oldPoints[MAX_MANIFOLD_COUNT];
+	std::copy(m_manifold.points, m_manifold.points + oldPointsCount, oldPoints);
+
+	m_manifold.pointsCount = 0;
+	SphereToBoxContact::evaluate(m_manifold, transformA, transformB);
+	return finishManifold(reuseThreshold, oldPoints, oldPointsCount, transformA, transformB);
+}
+
+// 구 중심을 box의 local 좌표로 옮겨 box 범위로 clamp한 점이 box 위 최근접점
+// 중심이 box 안에 있으면 가장 가까운 면 방향으로 밀어냄
+void SphereToBoxContact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
+{
+	ConvexInfo sphere = m_fixtureA->getShape()->getShapeInfo(transformA);
+	ConvexInfo box = m_fixtureB->getShape()->getShapeInfo(transformB);
+
+	glm::vec3 distance = sphere.center - box.center;
+	glm::vec3 localCenter(glm::dot(distance, box.axes[0]), glm::dot(distance, box.axes[1]),
+						  glm::dot(distance, box.axes[2]));
+
+	uint32_t typeId = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+					  (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+	ManifoldPoint &manifoldPoint = manifold.points[0];
+
+	// computeClosestPoints와 같은 순서로 더해야 두 경로의 최근접점이 같음
+	const uint32_t featureScale[3] = {1, 3, 9};
+	glm::vec3 closestPoint = box.center;
+	uint32_t feature = 0;
+	bool isInside = true;
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		float halfSize = box.halfSize[axis];
+		float value = localCenter[axis];
+		uint32_t digit = 1;
+		if (value > halfSize)
+		{
+			value = halfSize;
+			digit = 2;
+			isInside = false;
+		}
+		else if (value < -halfSize)
+		{
+			value = -halfSize;
+			digit = 0;
+			isInside = false;
+		}
+
+		closestPoint += box.axes[axis] * value;
+		feature += digit * featureScale[axis];
+	}
+
+	if (isInside == false)
+	{
+		if (setSphereContact(manifoldPoint, sphere.center, sphere.radius, closestPoint, 0.0f))
+		{
+			manifoldPoint.id = typeId | feature;
+			manifold.pointsCount = 1;
+		}
+		return;
+	}
+
+	int32_t minAxis = 0;
+	float minDistance = FLT_MAX;
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		float faceDistance = box.halfSize[axis] - std::abs(localCenter[axis]);
+		if (faceDistance < minDistance)
+		{
+			minDistance = faceDistance;
+			minAxis = axis;
+		}
+	}
+
+	float sign = localCenter[minAxis] < 0.0f ? -1.0f : 1.0f;
+	glm::vec3 normal = -box.axes[minAxis] * sign;
 
-	return point;
+	manifoldPoint.normal = normal;
+	manifoldPoint.seperation = sphere.radius + minDistance;
+	manifoldPoint.pointA = sphere.center + normal * sphere.radius;
+	manifoldPoint.pointB = sphere.center - normal * minDistance;
+	manifoldPoint.id = typeId | (static_cast<uint32_t>(minAxis * 2 + (sign < 0.0f ? 1 : 0)) << 10) | 31u;
+	manifold.pointsCount = 1;
 }
 
 void SphereToBoxContact::findCollisionPoints(const ConvexInfo &sphere, const ConvexInfo &box,
@@ -17,27 +17,29 @@ Contact *SphereToCapsuleContact::create(Fixture *fixtureA, Fixture *fixtureB, in
 		SphereToCapsuleContact(fixtureA, fixtureB, indexA, indexB);
 }
 
-glm::vec3 SphereToCapsuleContact::supportA(const ConvexInfo &sphere, glm::vec3 dir)
+void SphereToCapsuleContact::destroy(Contact *contact)
 {
-	return sphere.center + dir * sphere.radius;
+	static_cast<SphereToCapsuleContact *>(contact)->~SphereToCapsuleContact();
+	PhysicsAllocator::m_blockAllocator.freeBlock(contact, sizeof(SphereToCapsuleContact));
 }
 
-glm::vec3 SphereToCapsuleContact::supportB(const ConvexInfo &capsule, glm::vec3 dir)
+// 구 중심에서 capsule 선분 위 가장 가까운 점을 구하고 두 구의 충돌로 처리
+void SphereToCapsuleContact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
 {
-	float dotResult = glm::dot(dir, capsule.axes[0]);
+	ConvexInfo sphere = m_fixtureA->getShape()->getShapeInfo(transformA);
+	ConvexInfo capsule = m_fixtureB->getShape()->getShapeInfo(transformB);
 
-	glm::vec3 move(0.0f);
+	float halfHeight = capsule.height * 0.5f;
+	float t = std::clamp(glm::dot(sphere.center - capsule.center, capsule.axes[0]), -halfHeight, halfHeight);
+	glm::vec3 closestPoint = capsule.center + capsule.axes[0] * t;
 
-	if (dotResult > 0)
+	ManifoldPoint &manifoldPoint = manifold.points[0];
+	if (setSphereContact(manifoldPoint, sphere.center, sphere.radius, closestPoint, capsule.radius))
 	{
-		move = capsule.axes[0] * capsule.height * 0.5f;
+		manifoldPoint.id = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+						   (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+		manifold.pointsCount = 1;
 	}
-	else if (dotResult < 0)
-	{
-		move = -capsule.axes[0] * capsule.height * 0.5f;
-	}
-
-	return capsule.center + move + dir * capsule.radius;
 }
 
 void SphereToCapsuleContact::findCollisionPoints(const ConvexInfo &sphere, const ConvexInfo &capsule,
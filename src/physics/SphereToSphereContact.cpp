@@ -16,14 +16,78 @@ Contact *SphereToSphereContact::create(Fixture *fixtureA, Fixture *fixtureB, int
 	return new (static_cast<SphereToSphereContact *>(memory)) SphereToSphereContact(fixtureA, fixtureB, indexA, indexB);
 }
 
-glm::vec3 SphereToSphereContact::supportA(const ConvexInfo &sphere, glm::vec3 dir)
+void SphereToSphereContact::destroy(Contact *contact)
 {
-	return sphere.center + dir * sphere.radius;
+	static_cast<SphereToSphereContact *>(contact)->~SphereToSphereContact();
+	PhysicsAllocator::m_blockAllocator.freeBlock(contact, sizeof(SphereToSphereContact));
 }
 
-glm::vec3 SphereToSphereContact::supportB(const ConvexInfo &sphere, glm::vec3 dir)
+// manifold를 재사용하지 않는 contact의 구 중심을 SoA로 모아 SIMD kernel로 한 번에 검사
+void SphereToSphereContact::updateContacts(ContactUpdate *contactUpdates, const int32_t *order, int32_t count,
+										   const ManifoldReuseThreshold &reuseThreshold)
 {
-	return sphere.center + dir * sphere.radius;
+	SphereBatch batch;
+	int32_t i = 0;
+	while (i < count)
+	{
+		batch.count = 0;
+		for (; i < count && batch.count < SPHERE_BATCH_SIZE; ++i)
+		{
+			ContactUpdate &contactUpdate = contactUpdates[order[i]];
+			SphereToSphereContact *contact = static_cast<SphereToSphereContact *>(contactUpdate.contact);
+			const Transform &transformA = contact->m_fixtureA->getBody()->getTransform();
+			const Transform &transformB = contact->m_fixtureB->getBody()->getTransform();
+
+			if (contact->reuseManifold(reuseThreshold, transformA, transformB))
+			{
+				contactUpdate.touching = true;
+				continue;
+			}
+
+			const SphereShape *sphereA = static_cast<const SphereShape *>(contact->m_fixtureA->getShape());
+			const SphereShape *sphereB = static_cast<const SphereShape *>(contact->m_fixtureB->getShape());
+			glm::vec3 centerA = transformA.position + glm::normalize(transformA.orientation) * sphereA->m_center;
+			glm::vec3 centerB = transformB.position + glm::normalize(transformB.orientation) * sphereB->m_center;
+
+			int32_t lane = batch.count;
+			batch.centerAX[lane] = centerA.x;
+			batch.centerAY[lane] = centerA.y;
+			batch.centerAZ[lane] = centerA.z;
+			batch.radiusA[lane] = sphereA->m_radius;
+			batch.centerBX[lane] = centerB.x;
+			batch.centerBY[lane] = centerB.y;
+			batch.centerBZ[lane] = centerB.z;
+			batch.radiusB[lane] = sphereB->m_radius;
+			batch.contactUpdates[lane] = &contactUpdate;
+			++batch.count;
+		}
+
+		computeSphereContacts(batch);
+
+		for (int32_t lane = 0; lane < batch.count; ++lane)
+		{
+			ContactUpdate *contactUpdate = batch.contactUpdates[lane];
+			SphereToSphereContact *contact = static_cast<SphereToSphereContact *>(contactUpdate->contact);
+			uint32_t typeId = (static_cast<uint32_t>(contact->m_fixtureA->getType()) << 18) |
+							  (static_cast<uint32_t>(contact->m_fixtureB->getType()) << 13);
+			contactUpdate->touching = contact->applySphereContact(reuseThreshold, batch, lane, typeId);
+		}
+	}
+}
+
+// 중심 거리만으로 충돌 여부와 접촉점을 바로 계산
+void SphereToSphereContact::evaluate(Manifold &manifold, const Transform &transformA, const Transform &transformB)
+{
+	ConvexInfo sphereA = m_fixtureA->getShape()->getShapeInfo(transformA);
+	ConvexInfo sphereB = m_fixtureB->getShape()->getShapeInfo(transformB);
+
+	ManifoldPoint &manifoldPoint = manifold.points[0];
+	if (setSphereContact(manifoldPoint, sphereA.center, sphereA.radius, sphereB.center, sphereB.radius))
+	{
+		manifoldPoint.id = (static_cast<uint32_t>(m_fixtureA->getType()) << 18) |
+						   (static_cast<uint32_t>(m_fixtureB->getType()) << 13);
+		manifold.pointsCount = 1;
+	}
 }
 
 void SphereToSphereContact::findCollisionPoints(const ConvexInfo &sphereA, const ConvexInfo &sphereB,
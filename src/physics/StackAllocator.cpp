@@ -6,15 +6,15 @@ StackAllocator::StackAllocator() : m_index(0), m_allocation(0), m_entryCount(0)
 
 StackAllocator::~StackAllocator()
 {
-	while (m_entryCount >= 0)
+	while (m_entryCount > 0)
 	{
-		StackEntry* entry = m_entries + m_entryCount;
-		
+		StackEntry *entry = m_entries + m_entryCount - 1;
+
 		if (entry->usedMalloc)
 		{
 			free(entry->data);
 		}
-		
+
 		--m_entryCount;
 	}
 }
@@ -0,0 +1,204 @@
+#include "physics/ThreadPool.h"
+
+namespace ale
+{
+
+ThreadPool::ThreadPool(int32_t workerCount)
+	: m_workerCount(workerCount), m_task(nullptr), m_generation(0), m_activeWorkers(0), m_stop(false)
+{
+	if (m_workerCount <= 0)
+	{
+		m_workerCount = std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()));
+	}
+
+	m_queues = std::make_unique<WorkQueue[]>(m_workerCount);
+	for (int32_t i = 0; i < m_workerCount; ++i)
+	{
+		m_queues[i].begin = 0;
+		m_queues[i].end = 0;
+	}
+
+	// worker 0은 parallelFor를 호출한 스레드
+	for (int32_t i = 1; i < m_workerCount; ++i)
+	{
+		m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_startCondition.notify_all();
+
+	for (std::thread &thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+int32_t ThreadPool::getWorkerCount() const
+{
+	return m_workerCount;
+}
+
+void ThreadPool::parallelFor(int32_t count, const TaskFunction &task)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	if (m_workerCount == 1 || count == 1)
+	{
+		for (int32_t i = 0; i < count; ++i)
+		{
+			task(i, 0);
+		}
+		return;
+	}
+
+	// task를 worker 수만큼 연속 구간으로 나눠 배분, 먼저 끝난 worker는 다른 worker의 구간을 훔쳐감
+	for (int32_t i = 0; i < m_workerCount; ++i)
+	{
+		std::lock_guard<std::mutex> lock(m_queues[i].mutex);
+		m_queues[i].begin = static_cast<int32_t>(static_cast<int64_t>(count) * i / m_workerCount);
+		m_queues[i].end = static_cast<int32_t>(static_cast<int64_t>(count) * (i + 1) / m_workerCount);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		m_exception = nullptr;
+		m_activeWorkers = m_workerCount - 1;
+		++m_generation;
+	}
+	m_startCondition.notify_all();
+
+	runTasks(0);
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_finishCondition.wait(lock, [this]() { return m_activeWorkers == 0; });
+		m_task = nullptr;
+		exception = m_exception;
+	}
+
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+
+void ThreadPool::workerLoop(int32_t workerIndex)
+{
+	int64_t generation = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_startCondition.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+			if (m_stop)
+			{
+				return;
+			}
+			generation = m_generation;
+		}
+
+		runTasks(workerIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_activeWorkers;
+			if (m_activeWorkers == 0)
+			{
+				m_finishCondition.notify_one();
+			}
+		}
+	}
+}
+
+void ThreadPool::runTasks(int32_t workerIndex)
+{
+	int32_t index;
+
+	// 작업 중에는 새 task가 추가되지 않으므로 모든 구간이 비면 종료
+	while (true)
+	{
+		if (popTask(workerIndex, index) == false)
+		{
+			if (stealTasks(workerIndex) == false)
+			{
+				break;
+			}
+			continue;
+		}
+
+		try
+		{
+			(*m_task)(index, workerIndex);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception)
+			{
+				m_exception = std::current_exception();
+			}
+		}
+	}
+}
+
+bool ThreadPool::popTask(int32_t workerIndex, int32_t &index)
+{
+	WorkQueue &queue = m_queues[workerIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if (queue.begin == queue.end)
+	{
+		return false;
+	}
+
+	index = queue.begin;
+	++queue.begin;
+	return true;
+}
+
+bool ThreadPool::stealTasks(int32_t workerIndex)
+{
+	for (int32_t i = 1; i < m_workerCount; ++i)
+	{
+		int32_t victimIndex = (workerIndex + i) % m_workerCount;
+		WorkQueue &victim = m_queues[victimIndex];
+
+		int32_t begin;
+		int32_t end;
+		{
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			int32_t remain = victim.end - victim.begin;
+			if (remain == 0)
+			{
+				continue;
+			}
+
+			// 남은 구간의 뒤쪽 절반을 가져옴
+			begin = victim.end - (remain + 1) / 2;
+			end = victim.end;
+			victim.end = begin;
+		}
+
+		WorkQueue &queue = m_queues[workerIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.begin = begin;
+		queue.end = end;
+		return true;
+	}
+
+	return false;
+}
+
+} // namespace ale
@@ -0,0 +1,130 @@
+#include "physics/WideTree.h"
+
+namespace ale
+{
+WideTree::WideTree()
+{
+	m_treeVersion = 0;
+	m_isBuilt = false;
+}
+
+void WideTree::update(const DynamicTree &tree)
+{
+	if (m_isBuilt && m_treeVersion == tree.getVersion())
+	{
+		return;
+	}
+	build(tree);
+}
+
+void WideTree::build(const DynamicTree &tree)
+{
+	m_nodes.clear();
+	m_buildStack.clear();
+	m_treeVersion = tree.getVersion();
+	m_isBuilt = true;
+
+	if (tree.m_root == nullNode)
+	{
+		return;
+	}
+
+	m_nodes.emplace_back();
+	m_buildStack.push_back({tree.m_root, 0});
+
+	while (m_buildStack.empty() == false)
+	{
+		std::pair<int32_t, int32_t> entry = m_buildStack.back();
+		m_buildStack.pop_back();
+
+		int32_t slots[WIDE_NODE_WIDTH];
+		int32_t slotCount = 0;
+		const TreeNode &binaryNode = tree.m_nodes[entry.first];
+		if (binaryNode.isLeaf())
+		{
+			slots[slotCount++] = entry.first;
+		}
+		else
+		{
+			slots[slotCount++] = binaryNode.child1;
+			slots[slotCount++] = binaryNode.child2;
+		}
+
+		// 표면적이 가장 큰 internal 자식을 두 자식으로 펼쳐서 4칸을 채움
+		while (slotCount < WIDE_NODE_WIDTH)
+		{
+			int32_t bestSlot = -1;
+			float bestSurface = -1.0f;
+			for (int32_t i = 0; i < slotCount; ++i)
+			{
+				const TreeNode &node = tree.m_nodes[slots[i]];
+				if (node.isLeaf() == false && node.aabb.getSurface() > bestSurface)
+				{
+					bestSurface = node.aabb.getSurface();
+					bestSlot = i;
+				}
+			}
+
+			if (bestSlot == -1)
+			{
+				break;
+			}
+
+			const TreeNode &expanded = tree.m_nodes[slots[bestSlot]];
+			slots[bestSlot] = expanded.child1;
+			slots[slotCount++] = expanded.child2;
+		}
+
+		for (int32_t i = 0; i < WIDE_NODE_WIDTH; ++i)
+		{
+			if (i >= slotCount)
+			{
+				AABB empty;
+				empty.lowerBound = glm::vec3(FLT_MAX);
+				empty.upperBound = glm::vec3(-FLT_MAX);
+				setSlot(entry.second, i, empty, nullNode, false);
+				continue;
+			}
+
+			const TreeNode &child = tree.m_nodes[slots[i]];
+			if (child.isLeaf())
+			{
+				setSlot(entry.second, i, child.aabb, slots[i], true);
+				continue;
+			}
+
+			// emplace_back으로 m_nodes가 재할당될 수 있어 index로만 접근
+			int32_t childWideId = static_cast<int32_t>(m_nodes.size());
+			m_nodes.emplace_back();
+			setSlot(entry.second, i, child.aabb, childWideId, false);
+			m_buildStack.push_back({slots[i], childWideId});
+		}
+	}
+}
+
+int32_t WideTree::getNodeCount() const
+{
+	return static_cast<int32_t>(m_nodes.size());
+}
+
+void WideTree::setSlot(int32_t wideId, int32_t slot, const AABB &aabb, int32_t child, bool isLeaf)
+{
+	WideNode &node = m_nodes[wideId];
+	if (slot == 0)
+	{
+		node.leafMask = 0;
+	}
+
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		node.bounds[axis][slot] = aabb.lowerBound[axis];
+		node.bounds[axis][WIDE_NODE_WIDTH + slot] = -aabb.upperBound[axis];
+	}
+	node.children[slot] = child;
+	if (isLeaf)
+	{
+		node.leafMask |= 1 << slot;
+	}
+}
+
+} // namespace ale
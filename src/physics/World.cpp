@@ -1,13 +1,13 @@
 #include "physics/World.h"
-#include "App.h"
-#include "Model.h"
 #include "physics/BoxShape.h"
+#include "physics/CapsuleShape.h"
+#include "physics/CylinderShape.h"
 #include "physics/Rigidbody.h"
 #include "physics/SphereShape.h"
 
 namespace ale
 {
-World::World(App &app) : m_app(app), m_rigidbodies(nullptr), m_rigidbodyCount(0) {};
+World::World() : m_rigidbodies(nullptr), m_rigidbodyCount(0), m_profile(), m_taskScheduler(nullptr) {};
 
 World::~World()
 {
@@ -37,6 +37,8 @@ void World::startFrame()
 void World::runPhysics(float duration)
 {
 	// std::cout << "start runPhysics\n";
+	Timer stepTimer;
+	Timer timer;
 
 	Rigidbody *body = m_rigidbodies;
 	while (body != nullptr)
@@ -53,34 +55,32 @@ void World::runPhysics(float duration)
 
 		body = body->next;
 	}
+	m_profile.integrate = timer.getMilliseconds();
 
 	// std::cout << "broad phase\n";
 	// update Possible Contact Pairs - BroadPhase
+	timer.reset();
 	m_contactManager.findNewContacts();
+	m_profile.broadPhase = timer.getMilliseconds();
 
 	// std::cout << "narrow phase\n";
 	// Process Contacts
+	timer.reset();
 	m_contactManager.collide();
+	m_profile.narrowPhase = timer.getMilliseconds();
+
 	// std::cout << "solve\n";
+	timer.reset();
 	solve(duration);
+	m_profile.solve = timer.getMilliseconds();
 
-	// std::cout << "transform setting\n";
-
-	body = m_rigidbodies;
-
-	while (body != nullptr)
-	{
-		m_app.setTransformById(body->getTransformId(), body->getTransform());
-		body = body->next;
-	}
+	// 갱신된 Transform은 getBodyList()로 순회하며 외부에서 가져감
+	m_profile.step = stepTimer.getMilliseconds();
 }
 
 void World::solve(float duration)
 {
 	// std::cout << "solve start\n";
-	// island 초기화
-	Island island(m_rigidbodyCount, m_contactManager.m_contactCount);
-
 	// 모든 body들의 플래그에 islandFlag 제거
 	for (Rigidbody *body = m_rigidbodies; body; body = body->next)
 	{
@@ -93,9 +93,23 @@ void World::solve(float duration)
 		contact->unsetFlag(EContactFlag::ISLAND);
 	}
 
-	// Body를 순회하며 island를 생성후 solve 처리
-	Rigidbody **stack = static_cast<Rigidbody **>(PhysicsAllocator::m_stackAllocator.allocateStack(m_rigidbodyCount));
+	// island들이 나눠 쓰는 body / contact 배열
+	// static body는 여러 island에 중복으로 들어갈 수 있지만 그때마다 contact가 하나 이상 추가되므로
+	// body 배열은 body 수 + contact 수면 충분
+	int32_t contactCount = m_contactManager.m_contactCount;
+	StackAllocator &allocator = PhysicsAllocator::m_stackAllocator;
+	Rigidbody **islandBodies =
+		static_cast<Rigidbody **>(allocator.allocateStack(sizeof(Rigidbody *) * (m_rigidbodyCount + contactCount)));
+	Contact **islandContacts = static_cast<Contact **>(allocator.allocateStack(sizeof(Contact *) * contactCount));
+	ContactBodyIndex *islandContactIndices =
+		static_cast<ContactBodyIndex *>(allocator.allocateStack(sizeof(ContactBodyIndex) * contactCount));
+
+	// Body를 순회하며 island 생성
+	Rigidbody **stack = static_cast<Rigidbody **>(allocator.allocateStack(sizeof(Rigidbody *) * m_rigidbodyCount));
 	int32_t stackPtr = 0;
+	int32_t bodyOffset = 0;
+	int32_t contactOffset = 0;
+	m_islands.clear();
 
 	// body 순회
 	for (Rigidbody *body = m_rigidbodies; body; body = body->next)
@@ -113,8 +127,8 @@ void World::solve(float duration)
 		}
 
 		// 현재 Body가 island 생성 가능하다 판단이 끝났으니
-		// island clear를 통해 새로운 island 생성
-		island.clear();
+		// 배열의 남은 영역에 새로운 island 생성
+		Island island(islandBodies + bodyOffset, islandContacts + contactOffset, islandContactIndices + contactOffset);
 		stack[stackPtr] = body;
 		++stackPtr;
 		body->setFlag(EBodyFlag::ISLAND); // body island 처리
@@ -149,10 +163,6 @@ void World::solve(float duration)
 					continue;
 				}
 
-				// std::cout << "add Contact\n";
-				// std::cout << "bodyA : " << contact->getNodeB()->other->getBodyId() << "\n";
-				// std::cout << "bodyB : " << contact->getNodeA()->other->getBodyId() << "\n";
-
 				// 위 조건을 다 충족하는 경우 island에 추가 후 island 플래그 on
 				island.add(contact);
 				contact->setFlag(EContactFlag::ISLAND);
@@ -172,66 +182,148 @@ void World::solve(float duration)
 			}
 		}
 
-		// 생성한 island 충돌 처리
-		island.solve(duration);
+		// static body의 islandIndex가 다음 island에서 덮어써지기 전에 contact 인덱스 기록
+		island.storeContactIndices();
 
 		// island의 staticBody들의 island 플래그 off
-		Rigidbody **islandBodies = island.m_bodies;
+		Rigidbody **bodies = island.m_bodies;
 		for (int32_t i = 0; i < island.m_bodyCount; ++i)
 		{
-
-			if (islandBodies[i]->getType() == EBodyType::STATIC_BODY)
+			if (bodies[i]->getType() == EBodyType::STATIC_BODY)
 			{
-				islandBodies[i]->unsetFlag(EBodyFlag::ISLAND);
+				bodies[i]->unsetFlag(EBodyFlag::ISLAND);
 			}
 		}
+
+		// body 하나짜리 island는 solve할 것이 없으므로 배열 영역을 다음 island가 재사용
+		if (island.m_bodyCount == 1)
+		{
+			continue;
+		}
+
+		bodyOffset += island.m_bodyCount;
+		contactOffset += island.m_contactCount;
+		m_islands.push_back(island);
 	}
 
-	island.destroy();
+	allocator.freeStack();
+
+	// 생성한 island 충돌 처리
+	solveIslands(duration);
+
+	// broadphase는 공유 자원이므로 solve가 모두 끝난 뒤 순서대로 갱신
+	for (Island &island : m_islands)
+	{
+		island.synchronizeFixtures();
+	}
 
-	PhysicsAllocator::m_stackAllocator.freeStack();
+	allocator.freeStack();
+	allocator.freeStack();
+	allocator.freeStack();
 	// std::cout << "finish solve\n\n\n";
 }
 
-void World::createBody(std::unique_ptr<Model> &model, int32_t xfId)
+void World::solveIslands(float duration)
+{
+	int32_t islandCount = static_cast<int32_t>(m_islands.size());
+
+	if (m_taskScheduler == nullptr)
+	{
+		for (Island &island : m_islands)
+		{
+			island.solve(duration, PhysicsAllocator::m_stackAllocator, nullptr);
+		}
+		return;
+	}
+
+	// 큰 island는 하나씩 돌면서 island 내부의 contact들을 color 단위로 병렬 처리
+	// 나머지 island는 island 단위로 병렬 처리
+	m_smallIslands.clear();
+	for (int32_t i = 0; i < islandCount; ++i)
+	{
+		if (m_islands[i].m_contactCount >= Island::PARALLEL_SOLVE_CONTACT_COUNT)
+		{
+			m_islands[i].solve(duration, PhysicsAllocator::m_stackAllocator, m_taskScheduler);
+		}
+		else
+		{
+			m_smallIslands.push_back(i);
+		}
+	}
+
+	// 각 island는 서로 다른 dynamic body와 contact만 수정하므로 동시에 solve 가능
+	// 스택 메모리는 worker마다 따로 사용
+	m_taskScheduler->parallelFor(static_cast<int32_t>(m_smallIslands.size()),
+								 [this, duration](int32_t index, int32_t workerIndex) {
+									 m_islands[m_smallIslands[index]].solve(
+										 duration, *m_workerStackAllocators[workerIndex], nullptr);
+								 });
+}
+
+void World::setContactListener(ContactListener *listener)
+{
+	m_contactManager.m_contactListener = listener;
+}
+
+void World::setManifoldReuseThreshold(float linearThreshold, float angularThreshold)
+{
+	m_contactManager.setManifoldReuseThreshold(linearThreshold, angularThreshold);
+}
+
+void World::setTaskScheduler(TaskScheduler *scheduler)
+{
+	m_taskScheduler = scheduler;
+	m_contactManager.setTaskScheduler(scheduler);
+	m_workerStackAllocators.clear();
+
+	if (m_taskScheduler == nullptr)
+	{
+		return;
+	}
+
+	for (int32_t i = 0; i < m_taskScheduler->getWorkerCount(); ++i)
+	{
+		m_workerStackAllocators.push_back(std::make_unique<StackAllocator>());
+	}
+}
+
+void World::createBody(Shape *shape, const Transform &xf, int32_t xfId)
 {
 	// std::cout << "World::Create Body\n";
-	Shape *shape = model->getShape();
 	EType type = shape->getType();
 
 	switch (type)
 	{
 	case EType::SPHERE:
-		createSphere(model, xfId);
+		createSphere(shape, xf, xfId);
 		break;
 	case EType::BOX:
-		createBox(model, xfId);
+		createBox(shape, xf, xfId);
 		break;
 	case EType::GROUND:
-		createGround(model, xfId);
+		createGround(shape, xf, xfId);
 		break;
 	case EType::CYLINDER:
-		createCylinder(model, xfId);
+		createCylinder(shape, xf, xfId);
 		break;
 	case EType::CAPSULE:
-		createCapsule(model, xfId);
+		createCapsule(shape, xf, xfId);
 		break;
 	default:
 		break;
 	}
 }
 
-void World::createBox(std::unique_ptr<Model> &model, int32_t xfId)
+void World::createBox(Shape *s, const Transform &xf, int32_t xfId)
 {
 	// std::cout << "World::Create Box\n";
-	Shape *s = model->getShape();
 	BoxShape *shape = dynamic_cast<BoxShape *>(s);
 	BodyDef bd;
 
 	bd.m_type = EBodyType::DYNAMIC_BODY;
 
-	bd.m_position = m_app.getTransformById(xfId).position;
-	bd.m_orientation = m_app.getTransformById(xfId).orientation;
+	bd.m_position = xf.position;
+	bd.m_orientation = xf.orientation;
 	bd.m_xfId = xfId;
 	bd.m_linearDamping = 0.001f;
 	bd.m_angularDamping = 0.001f;
@@ -273,17 +365,16 @@ void World::createBox(std::unique_ptr<Model> &model, int32_t xfId)
 	++m_rigidbodyCount;
 }
 
-void World::createSphere(std::unique_ptr<Model> &model, int32_t xfId)
+void World::createSphere(Shape *s, const Transform &xf, int32_t xfId)
 {
 	// std::cout << "World::Create Sphere\n";
-	Shape *s = model->getShape();
 	SphereShape *shape = dynamic_cast<SphereShape *>(s);
 
 	BodyDef bd;
 	// set sphere definition
 	bd.m_type = EBodyType::DYNAMIC_BODY;
-	bd.m_position = m_app.getTransformById(xfId).position;
-	bd.m_orientation = m_app.getTransformById(xfId).orientation;
+	bd.m_position = xf.position;
+	bd.m_orientation = xf.orientation;
 	bd.m_xfId = xfId;
 	bd.m_linearDamping = 0.001f;
 	bd.m_angularDamping = 0.001f;
@@ -319,15 +410,14 @@ void World::createSphere(std::unique_ptr<Model> &model, int32_t xfId)
 	// std::cout << "World:: Create Sphere end\n";
 }
 
-void World::createGround(std::unique_ptr<Model> &model, int32_t xfId)
+void World::createGround(Shape *s, const Transform &xf, int32_t xfId)
 {
 	// std::cout << "World::Create Box\n";
-	Shape *s = model->getShape();
 	BoxShape *shape = dynamic_cast<BoxShape *>(s);
 	BodyDef bd;
 
-	bd.m_position = m_app.getTransformById(xfId).position;
-	bd.m_orientation = m_app.getTransformById(xfId).orientation;
+	bd.m_position = xf.position;
+	bd.m_orientation = xf.orientation;
 	bd.m_xfId = xfId;
 	bd.m_linearDamping = 0.0f;
 	bd.m_angularDamping = 0.0f;
@@ -360,16 +450,15 @@ void World::createGround(std::unique_ptr<Model> &model, int32_t xfId)
 	++m_rigidbodyCount;
 }
 
-void World::createCylinder(std::unique_ptr<Model> &model, int32_t xfId)
+void World::createCylinder(Shape *s, const Transform &xf, int32_t xfId)
 {
-	Shape *s = model->getShape();
 	CylinderShape *shape = dynamic_cast<CylinderShape *>(s);
 	BodyDef bd;
 
 	bd.m_type = EBodyType::DYNAMIC_BODY;
 
-	bd.m_position = m_app.getTransformById(xfId).position;
-	bd.m_orientation = m_app.getTransformById(xfId).orientation;
+	bd.m_position = xf.position;
+	bd.m_orientation = xf.orientation;
 	bd.m_xfId = xfId;
 	bd.m_linearDamping = 0.001f;
 	bd.m_angularDamping = 0.001f;
@@ -408,16 +497,15 @@ void World::createCylinder(std::unique_ptr<Model> &model, int32_t xfId)
 	++m_rigidbodyCount;
 }
 
-void World::createCapsule(std::unique_ptr<Model> &model, int32_t xfId)
+void World::createCapsule(Shape *s, const Transform &xf, int32_t xfId)
 {
-	Shape *s = model->getShape();
 	CapsuleShape *shape = dynamic_cast<CapsuleShape *>(s);
 	BodyDef bd;
 
 	bd.m_type = EBodyType::DYNAMIC_BODY;
 
-	bd.m_position = m_app.getTransformById(xfId).position;
-	bd.m_orientation = m_app.getTransformById(xfId).orientation;
+	bd.m_position = xf.position;
+	bd.m_orientation = xf.orientation;
 	bd.m_xfId = xfId;
 	bd.m_linearDamping = 0.001f;
 	bd.m_angularDamping = 0.001f;
@@ -465,6 +553,57 @@ void World::createCapsule(std::unique_ptr<Model> &model, int32_t xfId)
 	++m_rigidbodyCount;
 }
 
+void World::destroyBody(Rigidbody *body)
+{
+	// 연결된 contact 제거, 받치고 있던 body가 잠들어 있으면 깨워서 다시 떨어지게 함
+	ContactLink *link = body->getContactLinks();
+	while (link)
+	{
+		ContactLink *next = link->next;
+		link->other->setAwake();
+		m_contactManager.destroy(link->contact);
+		link = next;
+	}
+	body->setContactLinks(nullptr);
+
+	// broadphase tree에서 proxy 제거
+	body->destroyProxies();
+
+	// world body list에서 제거
+	if (body->prev != nullptr)
+	{
+		body->prev->next = body->next;
+	}
+	if (body->next != nullptr)
+	{
+		body->next->prev = body->prev;
+	}
+	if (body == m_rigidbodies)
+	{
+		m_rigidbodies = body->next;
+	}
+	--m_rigidbodyCount;
+
+	// fixture, shape는 body 소멸자에서 반환
+	body->~Rigidbody();
+	PhysicsAllocator::m_blockAllocator.freeBlock(body, sizeof(Rigidbody));
+}
+
+Rigidbody *World::getBodyList()
+{
+	return m_rigidbodies;
+}
+
+int32_t World::getBodyCount() const
+{
+	return m_rigidbodyCount;
+}
+
+const Profile &World::getProfile() const
+{
+	return m_profile;
+}
+
 void World::registerBodyForce(int32_t idx, const glm::vec3 &force)
 {
 	// check idx